@@ -0,0 +1,197 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <new>
+
+#include "common/assert.h"
+#include "common/host_memory.h"
+#include "common/logging/log.h"
+#include "common/scope_exit.h"
+
+namespace Common {
+
+constexpr std::size_t PAGE_ALIGNMENT = 0x1000;
+
+#ifdef __linux__
+
+class HostMemory::Impl {
+public:
+    explicit Impl(std::size_t backing_size_, std::size_t virtual_size_)
+        : backing_size{backing_size_}, virtual_size{virtual_size_} {
+        bool good = false;
+        SCOPE_EXIT({
+            if (!good) {
+                Release();
+            }
+        });
+
+        // Backing memory initialization
+        fd = memfd_create("HostMemory", 0);
+        if (fd == -1) {
+            LOG_CRITICAL(HW_Memory, "memfd_create failed: {}", std::strerror(errno));
+            throw std::bad_alloc{};
+        }
+
+        // Defined to extend the file with zeros
+        if (ftruncate(fd, static_cast<off_t>(backing_size)) != 0) {
+            LOG_CRITICAL(HW_Memory, "ftruncate failed with {}, are you out-of-memory?",
+                         std::strerror(errno));
+            throw std::bad_alloc{};
+        }
+
+        backing_base = static_cast<u8*>(
+            mmap(nullptr, backing_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        if (backing_base == MAP_FAILED) {
+            LOG_CRITICAL(HW_Memory, "mmap failed: {}", std::strerror(errno));
+            throw std::bad_alloc{};
+        }
+
+        // Virtual memory initialization, the range is only reserved until pages are mirrored
+        virtual_base = static_cast<u8*>(mmap(nullptr, virtual_size, PROT_NONE,
+                                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+        if (virtual_base == MAP_FAILED) {
+            LOG_CRITICAL(HW_Memory, "mmap failed: {}", std::strerror(errno));
+            throw std::bad_alloc{};
+        }
+
+        good = true;
+    }
+
+    ~Impl() {
+        Release();
+    }
+
+    void Map(std::size_t virtual_offset, std::size_t host_offset, std::size_t length) {
+        void* const ret = mmap(virtual_base + virtual_offset, length, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_FIXED, fd, static_cast<off_t>(host_offset));
+        ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", std::strerror(errno));
+    }
+
+    void Unmap(std::size_t virtual_offset, std::size_t length) {
+        // Replacing the mirror with an anonymous reservation keeps the range ours
+        void* const ret = mmap(virtual_base + virtual_offset, length, PROT_NONE,
+                               MAP_FIXED | MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+        ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", std::strerror(errno));
+    }
+
+    void Protect(std::size_t virtual_offset, std::size_t length, bool read, bool write) {
+        int flags = 0;
+        if (read) {
+            flags |= PROT_READ;
+        }
+        if (write) {
+            flags |= PROT_WRITE;
+        }
+        const int ret = mprotect(virtual_base + virtual_offset, length, flags);
+        ASSERT_MSG(ret == 0, "mprotect failed: {}", std::strerror(errno));
+    }
+
+    const std::size_t backing_size; ///< Size of the backing memory in bytes
+    const std::size_t virtual_size; ///< Size of the virtual address placeholder in bytes
+
+    u8* backing_base{reinterpret_cast<u8*>(MAP_FAILED)};
+    u8* virtual_base{reinterpret_cast<u8*>(MAP_FAILED)};
+
+private:
+    /// Release all resources in the object
+    void Release() {
+        if (virtual_base != MAP_FAILED) {
+            const int ret = munmap(virtual_base, virtual_size);
+            ASSERT_MSG(ret == 0, "munmap failed: {}", std::strerror(errno));
+        }
+        if (backing_base != MAP_FAILED) {
+            const int ret = munmap(backing_base, backing_size);
+            ASSERT_MSG(ret == 0, "munmap failed: {}", std::strerror(errno));
+        }
+        if (fd != -1) {
+            const int ret = close(fd);
+            ASSERT_MSG(ret == 0, "close failed: {}", std::strerror(errno));
+        }
+    }
+
+    int fd{-1}; ///< memfd file descriptor, -1 is the error value of memfd_create
+};
+
+#else // ^^^ Linux ^^^ vvv Generic vvv
+
+class HostMemory::Impl {
+public:
+    explicit Impl(std::size_t /*backing_size */, std::size_t /* virtual_size */) {
+        // This is just a placeholder.
+        // Please implement fastmem in a proper way on your platform.
+        throw std::bad_alloc{};
+    }
+
+    void Map(std::size_t virtual_offset, std::size_t host_offset, std::size_t length) {}
+
+    void Unmap(std::size_t virtual_offset, std::size_t length) {}
+
+    void Protect(std::size_t virtual_offset, std::size_t length, bool read, bool write) {}
+
+    u8* backing_base{nullptr};
+    u8* virtual_base{nullptr};
+};
+
+#endif // ^^^ Generic ^^^
+
+HostMemory::HostMemory(std::size_t backing_size_, std::size_t virtual_size_)
+    : backing_size{backing_size_}, virtual_size{virtual_size_} {
+    try {
+        // Try to allocate a fastmem arena.
+        // The implementation will fail with std::bad_alloc on errors.
+        impl = std::make_unique<HostMemory::Impl>(backing_size, virtual_size);
+        backing_base = impl->backing_base;
+        virtual_base = impl->virtual_base;
+    } catch (const std::bad_alloc&) {
+        LOG_CRITICAL(HW_Memory,
+                     "Fastmem unavailable, falling back to VirtualBuffer for memory allocation");
+        fallback_buffer = std::make_unique<Common::VirtualBuffer<u8>>(backing_size);
+        backing_base = fallback_buffer->data();
+        virtual_base = nullptr;
+    }
+}
+
+HostMemory::~HostMemory() = default;
+
+void HostMemory::Map(std::size_t virtual_offset, std::size_t host_offset, std::size_t length) {
+    ASSERT(virtual_offset % PAGE_ALIGNMENT == 0);
+    ASSERT(host_offset % PAGE_ALIGNMENT == 0);
+    ASSERT(length % PAGE_ALIGNMENT == 0);
+    ASSERT(virtual_offset + length <= virtual_size);
+    ASSERT(host_offset + length <= backing_size);
+    if (length == 0 || !virtual_base || !impl) {
+        return;
+    }
+    impl->Map(virtual_offset, host_offset, length);
+}
+
+void HostMemory::Unmap(std::size_t virtual_offset, std::size_t length) {
+    ASSERT(virtual_offset % PAGE_ALIGNMENT == 0);
+    ASSERT(length % PAGE_ALIGNMENT == 0);
+    ASSERT(virtual_offset + length <= virtual_size);
+    if (length == 0 || !virtual_base || !impl) {
+        return;
+    }
+    impl->Unmap(virtual_offset, length);
+}
+
+void HostMemory::Protect(std::size_t virtual_offset, std::size_t length, bool read, bool write) {
+    ASSERT(virtual_offset % PAGE_ALIGNMENT == 0);
+    ASSERT(length % PAGE_ALIGNMENT == 0);
+    ASSERT(virtual_offset + length <= virtual_size);
+    if (length == 0 || !virtual_base || !impl) {
+        return;
+    }
+    impl->Protect(virtual_offset, length, read, write);
+}
+
+} // namespace Common
@@ -0,0 +1,64 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/virtual_buffer.h"
+
+namespace Common {
+
+/**
+ * A low level linear memory buffer, which supports multiple mappings of the same backing memory.
+ * The backing buffer behaves like a regular allocation, while pages of it can be mirrored into a
+ * reserved virtual range and protected individually there. Platforms that cannot share memory
+ * between two host addresses only get the backing buffer, and VirtualBasePointer returns null.
+ */
+class HostMemory final : NonCopyable {
+public:
+    explicit HostMemory(std::size_t backing_size_, std::size_t virtual_size_);
+    ~HostMemory();
+
+    /// Mirrors length bytes of the backing buffer at host_offset into the virtual range.
+    void Map(std::size_t virtual_offset, std::size_t host_offset, std::size_t length);
+
+    /// Removes a mirror from the virtual range, accesses to it will fault.
+    void Unmap(std::size_t virtual_offset, std::size_t length);
+
+    /// Changes the access rights of a range of pages in the virtual range.
+    void Protect(std::size_t virtual_offset, std::size_t length, bool read, bool write);
+
+    [[nodiscard]] u8* BackingBasePointer() noexcept {
+        return backing_base;
+    }
+    [[nodiscard]] const u8* BackingBasePointer() const noexcept {
+        return backing_base;
+    }
+
+    [[nodiscard]] u8* VirtualBasePointer() noexcept {
+        return virtual_base;
+    }
+    [[nodiscard]] const u8* VirtualBasePointer() const noexcept {
+        return virtual_base;
+    }
+
+private:
+    class Impl;
+
+    std::size_t backing_size{};
+    std::size_t virtual_size{};
+
+    // Low level handler for the platform dependent memory routines
+    std::unique_ptr<Impl> impl;
+    u8* backing_base{};
+    u8* virtual_base{};
+
+    // Fallback if fastmem is not supported on this platform
+    std::unique_ptr<Common::VirtualBuffer<u8>> fallback_buffer;
+};
+
+} // namespace Common
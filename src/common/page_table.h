@@ -105,6 +105,9 @@ struct PageTable {
     VirtualBuffer<PageInfo> pointers;
 
     VirtualBuffer<u64> backing_addr;
+
+    /// Host mirror of the address space used by the JIT, null when fastmem is unavailable.
+    u8* fastmem_arena = nullptr;
 };
 
 } // namespace Common
@@ -11,11 +11,14 @@
 #include "common/page_table.h"
 #include "core/arm/cpu_interrupt_handler.h"
 #include "core/arm/dynarmic/arm_dynarmic_64.h"
+#include "core/arm/dynarmic/arm_dynarmic_jit_cache.h"
 #include "core/arm/dynarmic/arm_exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hardware_properties.h"
 #include "core/hle/kernel/k_scheduler.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/memory/page_table.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/svc.h"
 #include "core/memory.h"
@@ -25,6 +28,19 @@ namespace Core {
 
 using Vector = Dynarmic::A64::Vector;
 
+namespace {
+/// Hands the fastmem arena to the JIT. Dynarmic revisions without fastmem support don't have
+/// these options, the JIT then keeps going through the page table.
+template <typename UserConfig>
+void ConfigureFastmem(UserConfig& config, u8* fastmem_arena, std::size_t address_space_bits) {
+    if constexpr (requires { config.fastmem_pointer; }) {
+        config.fastmem_pointer = fastmem_arena;
+        config.fastmem_address_space_bits = address_space_bits;
+        config.silently_mirror_fastmem = false;
+    }
+}
+} // Anonymous namespace
+
 class DynarmicCallbacks64 : public Dynarmic::A64::UserCallbacks {
 public:
     explicit DynarmicCallbacks64(ARM_Dynarmic_64& parent) : parent(parent) {}
@@ -158,6 +174,11 @@ std::shared_ptr<Dynarmic::A64::Jit> ARM_Dynarmic_64::MakeJit(Common::PageTable&
     config.detect_misaligned_access_via_page_table = 16 | 32 | 64 | 128;
     config.only_detect_misalignment_via_page_table_on_page_boundary = true;
 
+    // Fastmem
+    const bool use_fastmem = Settings::values.cpu_accuracy != Settings::CPUAccuracy::DebugMode ||
+                             Settings::values.cpuopt_fastmem;
+    ConfigureFastmem(config, use_fastmem ? page_table.fastmem_arena : nullptr, address_space_bits);
+
     // Multi-process state
     config.processor_id = core_index;
     config.global_monitor = &exclusive_monitor.monitor;
@@ -342,14 +363,12 @@ void ARM_Dynarmic_64::ClearExclusiveState() {
 
 void ARM_Dynarmic_64::PageTableChanged(Common::PageTable& page_table,
                                        std::size_t new_address_space_size_in_bits) {
-    auto key = std::make_pair(&page_table, new_address_space_size_in_bits);
-    auto iter = jit_cache.find(key);
-    if (iter != jit_cache.end()) {
-        jit = iter->second;
-        return;
-    }
-    jit = MakeJit(page_table, new_address_space_size_in_bits);
-    jit_cache.emplace(key, jit);
+    // The page table belongs to the process being made current, its cache owns the instances
+    Kernel::Process* const process = system.Kernel().CurrentProcess();
+    ASSERT(process != nullptr && &process->PageTable().PageTableImpl() == &page_table);
+
+    jit = process->JitCache().Get(
+        core_index, [&] { return MakeJit(page_table, new_address_space_size_in_bits); });
 }
 
 } // namespace Core
@@ -5,11 +5,9 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
 
 #include <dynarmic/A64/a64.h>
 #include "common/common_types.h"
-#include "common/hash.h"
 #include "core/arm/arm_interface.h"
 #include "core/arm/exclusive_monitor.h"
 
@@ -64,13 +62,8 @@ private:
     std::shared_ptr<Dynarmic::A64::Jit> MakeJit(Common::PageTable& page_table,
                                                 std::size_t address_space_bits) const;
 
-    using JitCacheKey = std::pair<Common::PageTable*, std::size_t>;
-    using JitCacheType =
-        std::unordered_map<JitCacheKey, std::shared_ptr<Dynarmic::A64::Jit>, Common::PairHash>;
-
     friend class DynarmicCallbacks64;
     std::unique_ptr<DynarmicCallbacks64> cb;
-    JitCacheType jit_cache;
     std::shared_ptr<Dynarmic::A64::Jit> jit;
 
     std::size_t core_index;
@@ -0,0 +1,61 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <dynarmic/A64/a64.h>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "core/arm/dynarmic/arm_dynarmic_jit_cache.h"
+
+namespace Core {
+
+DynarmicJitCache64::DynarmicJitCache64() = default;
+
+DynarmicJitCache64::~DynarmicJitCache64() {
+    if (num_instances == 0) {
+        return;
+    }
+    const auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(build_time);
+    LOG_INFO(Core_ARM,
+             "JIT cache: {} instances built in {} ms, {} cache clears and {} range invalidations",
+             num_instances, build_ms.count(), num_clears, num_invalidations);
+}
+
+std::shared_ptr<Dynarmic::A64::Jit> DynarmicJitCache64::Get(std::size_t core_index,
+                                                            const Factory& factory) {
+    ASSERT(core_index < jits.size());
+
+    std::scoped_lock lock{mutex};
+    auto& jit = jits[core_index];
+    if (jit) {
+        return jit;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    jit = factory();
+    build_time += std::chrono::steady_clock::now() - start;
+    ++num_instances;
+    return jit;
+}
+
+void DynarmicJitCache64::ClearCache() {
+    std::scoped_lock lock{mutex};
+    for (const auto& jit : jits) {
+        if (jit) {
+            jit->ClearCache();
+        }
+    }
+    ++num_clears;
+}
+
+void DynarmicJitCache64::InvalidateCacheRange(VAddr addr, std::size_t size) {
+    std::scoped_lock lock{mutex};
+    for (const auto& jit : jits) {
+        if (jit) {
+            jit->InvalidateCacheRange(addr, size);
+        }
+    }
+    ++num_invalidations;
+}
+
+} // namespace Core
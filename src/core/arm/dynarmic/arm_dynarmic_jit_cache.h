@@ -0,0 +1,60 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Dynarmic::A64 {
+class Jit;
+}
+
+namespace Core {
+
+/**
+ * AArch64 JIT instances of a process, one per emulated core.
+ *
+ * The process owns the cache and each core owns its slot: a core only ever executes from its own
+ * instance, because dynarmic keeps the guest register state next to the block cache. Keeping the
+ * slots together lets the kernel invalidate translated code of the process on every core with a
+ * single call, including instances that are not currently bound, and releases them all together
+ * with the process.
+ */
+class DynarmicJitCache64 final : NonCopyable {
+public:
+    using Factory = std::function<std::shared_ptr<Dynarmic::A64::Jit>()>;
+
+    DynarmicJitCache64();
+    ~DynarmicJitCache64();
+
+    /// Returns the instance of a core, building it with factory on first use.
+    [[nodiscard]] std::shared_ptr<Dynarmic::A64::Jit> Get(std::size_t core_index,
+                                                          const Factory& factory);
+
+    /// Discards all translated code of the process.
+    void ClearCache();
+
+    /// Discards translated code that overlaps [addr, addr + size) in the process.
+    void InvalidateCacheRange(VAddr addr, std::size_t size);
+
+private:
+    mutable std::mutex mutex;
+    std::array<std::shared_ptr<Dynarmic::A64::Jit>, Hardware::NUM_CPU_CORES> jits;
+
+    std::size_t num_instances{};
+    std::size_t num_clears{};
+    std::size_t num_invalidations{};
+    std::chrono::nanoseconds build_time{};
+};
+
+} // namespace Core
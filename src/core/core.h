@@ -109,6 +109,8 @@ class System {
 public:
     using CurrentBuildProcessID = std::array<u8, 0x20>;
 
+    explicit System();
+
     System(const System&) = delete;
     System& operator=(const System&) = delete;
 
@@ -389,8 +391,6 @@ public:
     void ExecuteProgram(std::size_t program_index);
 
 private:
-    System();
-
     struct Impl;
     std::unique_ptr<Impl> impl;
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <mutex>
 
 #include "core/crypto/aes_util.h"
 #include "core/crypto/encryption_layer.h"
@@ -26,11 +27,16 @@ public:
 private:
     std::size_t base_offset;
 
-    // Must be mutable as operations modify cipher contexts.
+    // Must be mutable as operations modify cipher contexts. Reads from several threads share the
+    // context, it is locked while an IV is set and the data decrypted.
     mutable AESCipher<Key128> cipher;
-    mutable IVData iv{};
+    mutable std::mutex cipher_mutex;
+    IVData iv{};
 
-    void UpdateIV(std::size_t offset) const;
+    /// Returns the counter of the block at offset, computed from the IV of the layer
+    IVData CalculateIV(std::size_t offset) const;
+
+    void Decrypt(const u8* src, std::size_t size, u8* dest, std::size_t offset) const;
 };
 
 } // namespace Core::Crypto
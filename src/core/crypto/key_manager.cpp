@@ -12,6 +12,7 @@
 #include <sstream>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 #include <mbedtls/bignum.h>
 #include <mbedtls/cipher.h>
@@ -22,6 +23,7 @@
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
+#include "common/scope_exit.h"
 #include "common/string_util.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
@@ -128,6 +130,100 @@ template <std::size_t Size>
 bool IsAllZeroArray(const std::array<u8, Size>& array) {
     return std::all_of(array.begin(), array.end(), [](const auto& elem) { return elem == 0; });
 }
+
+constexpr u32 KEY_CACHE_MAGIC = 0x4B43595A; // ZYCK
+constexpr u32 KEY_CACHE_VERSION = 1;
+constexpr char KEY_CACHE_FILENAME[] = "keys.cache";
+
+struct KeyCacheHeader {
+    u32 magic;
+    u32 version;
+    u64 payload_size;
+    // Hash of the key files the cached keys were parsed from
+    SHA256Hash sources_hash;
+    SHA256Hash payload_hash;
+};
+static_assert(std::is_trivially_copyable_v<KeyCacheHeader>);
+
+template <typename KeyType, typename Key>
+struct KeyCacheEntry {
+    KeyType type;
+    u64 field1;
+    u64 field2;
+    Key key;
+};
+using Key128CacheEntry = KeyCacheEntry<S128KeyType, Key128>;
+using Key256CacheEntry = KeyCacheEntry<S256KeyType, Key256>;
+static_assert(sizeof(Key128CacheEntry) == 0x28, "Key128CacheEntry has incorrect size.");
+static_assert(sizeof(Key256CacheEntry) == 0x38, "Key256CacheEntry has incorrect size.");
+
+struct KeyFileSource {
+    std::string path;
+    bool title;
+};
+
+// Returns the key files loaded by KeyManager, in the order they are parsed. Files in the yuzu
+// keys directory take precedence over the hactool ones.
+std::vector<KeyFileSource> GetKeyFileSources(bool dev_mode) {
+    const std::string hactool_keys_dir = Common::FS::GetHactoolConfigurationPath();
+    const std::string yuzu_keys_dir = Common::FS::GetUserPath(Common::FS::UserPath::KeysDir);
+
+    std::vector<KeyFileSource> sources;
+    const auto add_source = [&sources](const std::string& dir1, const std::string& dir2,
+                                       const std::string& filename, bool title) {
+        if (Common::FS::Exists(dir1 + DIR_SEP + filename)) {
+            sources.push_back({dir1 + DIR_SEP + filename, title});
+        } else if (Common::FS::Exists(dir2 + DIR_SEP + filename)) {
+            sources.push_back({dir2 + DIR_SEP + filename, title});
+        }
+    };
+
+    const std::string keys_filename = dev_mode ? "dev.keys" : "prod.keys";
+    add_source(yuzu_keys_dir, hactool_keys_dir, keys_filename, false);
+    add_source(yuzu_keys_dir, yuzu_keys_dir, keys_filename + "_autogenerated", false);
+    add_source(yuzu_keys_dir, hactool_keys_dir, "title.keys", true);
+    add_source(yuzu_keys_dir, yuzu_keys_dir, "title.keys_autogenerated", true);
+    add_source(yuzu_keys_dir, hactool_keys_dir, "console.keys", false);
+    add_source(yuzu_keys_dir, yuzu_keys_dir, "console.keys_autogenerated", false);
+    return sources;
+}
+
+SHA256Hash HashKeyFiles(const std::vector<KeyFileSource>& sources, bool dev_mode) {
+    std::string state{dev_mode ? "dev" : "prod"};
+    for (const auto& source : sources) {
+        std::string contents;
+        Common::FS::ReadFileToString(false, source.path, contents);
+        state += fmt::format("\n{}:{}:{}\n", source.path, source.title, contents.size());
+        state += contents;
+    }
+
+    SHA256Hash hash{};
+    mbedtls_sha256_ret(reinterpret_cast<const u8*>(state.data()), state.size(), hash.data(), 0);
+    return hash;
+}
+
+std::string GetKeyCachePath() {
+    return Common::FS::GetUserPath(Common::FS::UserPath::KeysDir) + DIR_SEP + KEY_CACHE_FILENAME;
+}
+
+template <typename T>
+void AppendToCache(std::vector<u8>& buffer, const T& object) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &object, sizeof(T));
+}
+
+template <typename T>
+bool ReadFromCache(const std::vector<u8>& buffer, std::size_t& offset, T& object) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (sizeof(T) > buffer.size() - offset) {
+        return false;
+    }
+    std::memcpy(&object, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
 } // Anonymous namespace
 
 u64 GetSignatureTypeDataSize(SignatureType type) {
@@ -565,23 +661,22 @@ std::optional<std::pair<Key128, Key128>> ParseTicket(const Ticket& ticket,
 }
 
 KeyManager::KeyManager() {
+    dev_mode = Settings::values.use_dev_keys;
+
+    // Hashed before parsing, a file that changes in between only invalidates the cache
+    const auto sources = GetKeyFileSources(dev_mode);
+    const SHA256Hash sources_hash = HashKeyFiles(sources, dev_mode);
+    if (LoadCache(sources_hash)) {
+        return;
+    }
+
     // Initialize keys
-    const std::string hactool_keys_dir = Common::FS::GetHactoolConfigurationPath();
-    const std::string yuzu_keys_dir = Common::FS::GetUserPath(Common::FS::UserPath::KeysDir);
-    if (Settings::values.use_dev_keys) {
-        dev_mode = true;
-        AttemptLoadKeyFile(yuzu_keys_dir, hactool_keys_dir, "dev.keys", false);
-        AttemptLoadKeyFile(yuzu_keys_dir, yuzu_keys_dir, "dev.keys_autogenerated", false);
-    } else {
-        dev_mode = false;
-        AttemptLoadKeyFile(yuzu_keys_dir, hactool_keys_dir, "prod.keys", false);
-        AttemptLoadKeyFile(yuzu_keys_dir, yuzu_keys_dir, "prod.keys_autogenerated", false);
-    }
-
-    AttemptLoadKeyFile(yuzu_keys_dir, hactool_keys_dir, "title.keys", true);
-    AttemptLoadKeyFile(yuzu_keys_dir, yuzu_keys_dir, "title.keys_autogenerated", true);
-    AttemptLoadKeyFile(yuzu_keys_dir, hactool_keys_dir, "console.keys", false);
-    AttemptLoadKeyFile(yuzu_keys_dir, yuzu_keys_dir, "console.keys_autogenerated", false);
+    for (const auto& source : sources) {
+        LoadFromFile(source.path, source.title);
+    }
+    if (!sources.empty()) {
+        SaveCache(sources_hash);
+    }
 }
 
 static bool ValidCryptoRevisionString(std::string_view base, size_t begin, size_t length) {
@@ -689,12 +784,137 @@ void KeyManager::LoadFromFile(const std::string& filename, bool is_title_keys) {
     }
 }
 
-void KeyManager::AttemptLoadKeyFile(const std::string& dir1, const std::string& dir2,
-                                    const std::string& filename, bool title) {
-    if (Common::FS::Exists(dir1 + DIR_SEP + filename)) {
-        LoadFromFile(dir1 + DIR_SEP + filename, title);
-    } else if (Common::FS::Exists(dir2 + DIR_SEP + filename)) {
-        LoadFromFile(dir2 + DIR_SEP + filename, title);
+bool KeyManager::LoadCache(const SHA256Hash& sources_hash) {
+    const std::string path = GetKeyCachePath();
+    Common::FS::IOFile file{path, "rb"};
+    if (!file.IsOpen()) {
+        return false;
+    }
+    std::vector<u8> buffer(file.GetSize());
+    if (file.ReadBytes(buffer.data(), buffer.size()) != buffer.size()) {
+        return false;
+    }
+
+    std::size_t offset = 0;
+    KeyCacheHeader header{};
+    if (!ReadFromCache(buffer, offset, header) || header.magic != KEY_CACHE_MAGIC ||
+        header.version != KEY_CACHE_VERSION || header.payload_size != buffer.size() - offset) {
+        return false;
+    }
+
+    SHA256Hash payload_hash{};
+    mbedtls_sha256_ret(buffer.data() + offset, header.payload_size, payload_hash.data(), 0);
+    if (payload_hash != header.payload_hash) {
+        LOG_WARNING(Crypto, "Key cache at {} is corrupted, parsing the key files", path);
+        return false;
+    }
+    if (header.sources_hash != sources_hash) {
+        LOG_INFO(Crypto, "Key files changed since the key cache was written, parsing them");
+        return false;
+    }
+
+    u64 num_s128_keys{};
+    u64 num_s256_keys{};
+    if (!ReadFromCache(buffer, offset, num_s128_keys) ||
+        !ReadFromCache(buffer, offset, num_s256_keys) ||
+        num_s128_keys > buffer.size() / sizeof(Key128CacheEntry) ||
+        num_s256_keys > buffer.size() / sizeof(Key256CacheEntry)) {
+        return false;
+    }
+
+    // Everything is read aside first so a truncated cache doesn't leave partial keys behind
+    std::map<KeyIndex<S128KeyType>, Key128> cached_s128_keys;
+    std::map<KeyIndex<S256KeyType>, Key256> cached_s256_keys;
+    for (u64 i = 0; i < num_s128_keys; ++i) {
+        Key128CacheEntry entry{};
+        if (!ReadFromCache(buffer, offset, entry)) {
+            return false;
+        }
+        cached_s128_keys.emplace(KeyIndex<S128KeyType>{entry.type, entry.field1, entry.field2},
+                                 entry.key);
+    }
+    for (u64 i = 0; i < num_s256_keys; ++i) {
+        Key256CacheEntry entry{};
+        if (!ReadFromCache(buffer, offset, entry)) {
+            return false;
+        }
+        cached_s256_keys.emplace(KeyIndex<S256KeyType>{entry.type, entry.field1, entry.field2},
+                                 entry.key);
+    }
+
+    auto cached_encrypted_keyblobs = encrypted_keyblobs;
+    auto cached_keyblobs = keyblobs;
+    auto cached_eticket_extended_kek = eticket_extended_kek;
+    if (!ReadFromCache(buffer, offset, cached_encrypted_keyblobs) ||
+        !ReadFromCache(buffer, offset, cached_keyblobs) ||
+        !ReadFromCache(buffer, offset, cached_eticket_extended_kek) || offset != buffer.size()) {
+        return false;
+    }
+
+    s128_keys = std::move(cached_s128_keys);
+    s256_keys = std::move(cached_s256_keys);
+    encrypted_keyblobs = cached_encrypted_keyblobs;
+    keyblobs = cached_keyblobs;
+    eticket_extended_kek = cached_eticket_extended_kek;
+    return true;
+}
+
+void KeyManager::SaveCache(const SHA256Hash& sources_hash) const {
+    std::vector<u8> payload;
+    AppendToCache(payload, static_cast<u64>(s128_keys.size()));
+    AppendToCache(payload, static_cast<u64>(s256_keys.size()));
+    for (const auto& [index, key] : s128_keys) {
+        AppendToCache(payload, Key128CacheEntry{index.type, index.field1, index.field2, key});
+    }
+    for (const auto& [index, key] : s256_keys) {
+        AppendToCache(payload, Key256CacheEntry{index.type, index.field1, index.field2, key});
+    }
+    AppendToCache(payload, encrypted_keyblobs);
+    AppendToCache(payload, keyblobs);
+    AppendToCache(payload, eticket_extended_kek);
+
+    KeyCacheHeader header{
+        .magic = KEY_CACHE_MAGIC,
+        .version = KEY_CACHE_VERSION,
+        .payload_size = payload.size(),
+        .sources_hash = sources_hash,
+        .payload_hash = {},
+    };
+    mbedtls_sha256_ret(payload.data(), payload.size(), header.payload_hash.data(), 0);
+
+    // Written aside first so an interrupted write never leaves a truncated cache behind
+    const std::string path = GetKeyCachePath();
+    const std::string temp_path = path + ".tmp";
+    if (!Common::FS::CreateFullPath(path)) {
+        return;
+    }
+    {
+        Common::FS::IOFile file{temp_path, "wb"};
+        if (!file.IsOpen() || file.WriteObject(header) != 1 ||
+            file.WriteBytes(payload.data(), payload.size()) != payload.size()) {
+            LOG_ERROR(Crypto, "Failed to write key cache to {}", temp_path);
+            return;
+        }
+    }
+    if (Common::FS::Exists(path)) {
+        Common::FS::Delete(path);
+    }
+    if (!Common::FS::Rename(temp_path, path)) {
+        LOG_ERROR(Crypto, "Failed to move key cache to {}", path);
+    }
+}
+
+void KeyManager::InvalidateCache() {
+    if (!cache_dirty) {
+        return;
+    }
+    cache_dirty = false;
+
+    // The keys in memory are not necessarily the ones in the key files, the next start parses the
+    // files again and caches what they contain
+    const std::string path = GetKeyCachePath();
+    if (Common::FS::Exists(path) && !Common::FS::Delete(path)) {
+        LOG_ERROR(Crypto, "Failed to delete stale key cache at {}", path);
     }
 }
 
@@ -784,7 +1004,7 @@ void KeyManager::WriteKeyToFile(KeyCategory category, std::string_view keyname,
     }
 
     file.WriteString(fmt::format("\n{} = {}", keyname, Common::HexToString(key)));
-    AttemptLoadKeyFile(yuzu_keys_dir, yuzu_keys_dir, filename, category == KeyCategory::Title);
+    cache_dirty = true;
 }
 
 void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
@@ -873,6 +1093,7 @@ bool KeyManager::KeyFileExists(bool title) {
 }
 
 void KeyManager::DeriveSDSeedLazy() {
+    SCOPE_EXIT({ InvalidateCache(); });
     if (HasKey(S128KeyType::SDSeed)) {
         return;
     }
@@ -892,6 +1113,7 @@ static Key128 CalculateCMAC(const u8* source, size_t size, const Key128& key) {
 }
 
 void KeyManager::DeriveBase() {
+    SCOPE_EXIT({ InvalidateCache(); });
     if (!BaseDeriveNecessary()) {
         return;
     }
@@ -1022,6 +1244,7 @@ void KeyManager::DeriveBase() {
 
 void KeyManager::DeriveETicket(PartitionDataManager& data,
                                const FileSys::ContentProvider& provider) {
+    SCOPE_EXIT({ InvalidateCache(); });
     // ETicket keys
     const auto es = provider.GetEntry(0x0100000000000033, FileSys::ContentRecordType::Program);
 
@@ -1100,6 +1323,7 @@ void KeyManager::DeriveETicket(PartitionDataManager& data,
 }
 
 void KeyManager::PopulateTickets() {
+    SCOPE_EXIT({ InvalidateCache(); });
     const auto rsa_key = GetETicketRSAKey();
 
     if (rsa_key == RSAKeyPair<2048>{}) {
@@ -1172,6 +1396,7 @@ void KeyManager::SetKeyWrapped(S256KeyType id, Key256 key, u64 field1, u64 field
 }
 
 void KeyManager::PopulateFromPartitionData(PartitionDataManager& data) {
+    SCOPE_EXIT({ InvalidateCache(); });
     if (!BaseDeriveNecessary()) {
         return;
     }
@@ -1272,6 +1497,7 @@ const std::map<u128, Ticket>& KeyManager::GetPersonalizedTickets() const {
 }
 
 bool KeyManager::AddTicketCommon(Ticket raw) {
+    SCOPE_EXIT({ InvalidateCache(); });
     const auto rsa_key = GetETicketRSAKey();
     if (rsa_key == RSAKeyPair<2048>{}) {
         return false;
@@ -1291,6 +1517,7 @@ bool KeyManager::AddTicketCommon(Ticket raw) {
 }
 
 bool KeyManager::AddTicketPersonalized(Ticket raw) {
+    SCOPE_EXIT({ InvalidateCache(); });
     const auto rsa_key = GetETicketRSAKey();
     if (rsa_key == RSAKeyPair<2048>{}) {
         return false;
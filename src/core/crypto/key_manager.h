@@ -283,9 +283,20 @@ private:
     std::array<u8, 576> eticket_extended_kek{};
 
     bool dev_mode;
+
+    // Set when keys were written to the autogenerated key files since the cache was checked
+    bool cache_dirty = false;
+
     void LoadFromFile(const std::string& filename, bool is_title_keys);
-    void AttemptLoadKeyFile(const std::string& dir1, const std::string& dir2,
-                            const std::string& filename, bool title);
+
+    // Loads every key from the cache if it was written from key files with the given hash, returns
+    // false when the key files have to be parsed instead.
+    bool LoadCache(const SHA256Hash& sources_hash);
+    // Only called right after parsing the key files with the given hash
+    void SaveCache(const SHA256Hash& sources_hash) const;
+    // Deletes the cache if keys were derived or added, it no longer matches the key files
+    void InvalidateCache();
+
     template <size_t Size>
     void WriteKeyToFile(KeyCategory category, std::string_view keyname,
                         const std::array<u8, Size>& key);
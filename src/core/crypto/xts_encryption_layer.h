@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "core/crypto/aes_util.h"
 #include "core/crypto/encryption_layer.h"
 #include "core/crypto/key_manager.h"
@@ -18,8 +20,12 @@ public:
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
 
 private:
-    // Must be mutable as operations modify cipher contexts.
+    // Must be mutable as operations modify cipher contexts. Reads from several threads share the
+    // context, it is locked while the sector tweaks are set and the data decrypted.
     mutable AESCipher<Key256> cipher;
+    mutable std::mutex cipher_mutex;
+
+    void Decrypt(const u8* src, std::size_t size, u8* dest, std::size_t sector_id) const;
 };
 
 } // namespace Core::Crypto
@@ -22,8 +22,12 @@
  * Refer to the license.txt file included.
  */
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <numeric>
 #include <string_view>
+#include <thread>
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "core/file_sys/fsmitm_romfsbuild.h"
@@ -73,17 +77,18 @@ struct RomFSFileEntry {
 };
 static_assert(sizeof(RomFSFileEntry) == 0x20, "RomFSFileEntry has incorrect size.");
 
-struct RomFSBuildFileContext;
+// Build contexts live in flat arrays and refer to each other by index.
+constexpr u32 ROMFS_ROOT_INDEX = 0;
 
 struct RomFSBuildDirectoryContext {
     std::string path;
     u32 cur_path_ofs = 0;
     u32 path_len = 0;
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildDirectoryContext> child;
-    std::shared_ptr<RomFSBuildDirectoryContext> sibling;
-    std::shared_ptr<RomFSBuildFileContext> file;
+    u32 parent = ROMFS_ENTRY_EMPTY;
+    u32 child = ROMFS_ENTRY_EMPTY;
+    u32 sibling = ROMFS_ENTRY_EMPTY;
+    u32 file = ROMFS_ENTRY_EMPTY;
 };
 
 struct RomFSBuildFileContext {
@@ -93,8 +98,9 @@ struct RomFSBuildFileContext {
     u32 entry_offset = 0;
     u64 offset = 0;
     u64 size = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildFileContext> sibling;
+    u32 parent = ROMFS_ENTRY_EMPTY;
+    u32 sibling = ROMFS_ENTRY_EMPTY;
+    bool ips_patched = false;
     VirtualFile source;
 };
 
@@ -126,123 +132,138 @@ static u64 romfs_get_hash_table_count(u64 num_entries) {
     return count;
 }
 
-void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext,
-                                       std::shared_ptr<RomFSBuildDirectoryContext> parent) {
-    std::vector<std::shared_ptr<RomFSBuildDirectoryContext>> child_dirs;
+// Returns the indices of entries sorted by path, the order their tables are laid out in.
+template <typename Context>
+static std::vector<u32> romfs_sort_by_path(const std::vector<Context>& entries) {
+    std::vector<u32> order(entries.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::sort(order.begin(), order.end(),
+              [&entries](u32 lhs, u32 rhs) { return entries[lhs].path < entries[rhs].path; });
+    return order;
+}
+
+// Calls func for every index in [0, count), splitting large ranges across threads.
+template <typename Func>
+static void romfs_parallel_for(std::size_t count, const Func& func) {
+    constexpr std::size_t MIN_ENTRIES_PER_WORKER = 0x1000;
+    const std::size_t max_workers = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t num_workers =
+        std::clamp<std::size_t>(count / MIN_ENTRIES_PER_WORKER, 1, max_workers);
+    const std::size_t bucket_size = count / num_workers;
+
+    const auto run = [&func](std::size_t start, std::size_t end) {
+        for (std::size_t i = start; i < end; ++i) {
+            func(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers - 1);
+    for (std::size_t i = 1; i < num_workers; ++i) {
+        const bool is_last_worker = i + 1 == num_workers;
+        const std::size_t start = bucket_size * i;
+        const std::size_t end = is_last_worker ? count : start + bucket_size;
+        threads.emplace_back(run, start, end);
+    }
+    run(0, num_workers == 1 ? count : bucket_size);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext, u32 parent) {
+    // Copied, adding entries reallocates the context arrays
+    const std::string parent_path = directories[parent].path;
+    const u32 parent_path_len = directories[parent].path_len;
+
+    std::vector<u32> child_dirs;
 
     VirtualDir dir;
 
-    if (parent->path_len == 0)
+    if (parent_path_len == 0)
         dir = root_romfs;
     else
-        dir = root_romfs->GetDirectoryRelative(parent->path);
+        dir = root_romfs->GetDirectoryRelative(parent_path);
 
     const auto entries = dir->GetEntries();
 
     for (const auto& kv : entries) {
-        if (kv.second == VfsEntryType::Directory) {
-            const auto child = std::make_shared<RomFSBuildDirectoryContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
+        std::string path = parent_path + "/" + kv.first;
+        if (ext != nullptr && ext->GetFileRelative(path + ".stub") != nullptr)
+            continue;
 
-            if (ext != nullptr && ext->GetFileRelative(child->path + ".stub") != nullptr)
-                continue;
+        const u32 cur_path_ofs = parent_path_len + 1;
+        const u32 path_len = cur_path_ofs + static_cast<u32>(kv.first.size());
 
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
+        // Sanity check on path_len
+        ASSERT(path_len < FS_MAX_PATH);
 
-            if (AddDirectory(parent, child)) {
-                child_dirs.push_back(child);
-            }
-        } else {
-            const auto child = std::make_shared<RomFSBuildFileContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
-
-            if (ext != nullptr && ext->GetFileRelative(child->path + ".stub") != nullptr)
-                continue;
-
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
+        if (kv.second == VfsEntryType::Directory) {
+            RomFSBuildDirectoryContext child;
+            child.path = std::move(path);
+            child.cur_path_ofs = cur_path_ofs;
+            child.path_len = path_len;
 
-            child->source = root_romfs->GetFileRelative(child->path);
+            child_dirs.push_back(AddDirectory(parent, std::move(child)));
+        } else {
+            RomFSBuildFileContext child;
+            child.path = std::move(path);
+            child.cur_path_ofs = cur_path_ofs;
+            child.path_len = path_len;
+            child.source = root_romfs->GetFileRelative(child.path);
 
             if (ext != nullptr) {
-                const auto ips = ext->GetFileRelative(child->path + ".ips");
+                const auto ips = ext->GetFileRelative(child.path + ".ips");
 
                 if (ips != nullptr) {
-                    auto patched = PatchIPS(child->source, ips);
-                    if (patched != nullptr)
-                        child->source = std::move(patched);
+                    auto patched = PatchIPS(child.source, ips);
+                    if (patched != nullptr) {
+                        child.source = std::move(patched);
+                        child.ips_patched = true;
+                    }
                 }
             }
 
-            child->size = child->source->GetSize();
+            child.size = child.source->GetSize();
 
-            AddFile(parent, child);
+            AddFile(parent, std::move(child));
         }
     }
 
-    for (auto& child : child_dirs) {
+    for (const u32 child : child_dirs) {
         this->VisitDirectory(root_romfs, ext, child);
     }
 }
 
-bool RomFSBuildContext::AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                     std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx) {
-    // Check whether it's already in the known directories.
-    const auto existing = directories.find(dir_ctx->path);
-    if (existing != directories.end())
-        return false;
-
-    // Add a new directory.
-    num_dirs++;
+u32 RomFSBuildContext::AddDirectory(u32 parent, RomFSBuildDirectoryContext dir_ctx) {
+    // Entries of a directory have unique names, so paths are never added twice.
     dir_table_size +=
-        sizeof(RomFSDirectoryEntry) + Common::AlignUp(dir_ctx->path_len - dir_ctx->cur_path_ofs, 4);
-    dir_ctx->parent = parent_dir_ctx;
-    directories.emplace(dir_ctx->path, dir_ctx);
+        sizeof(RomFSDirectoryEntry) + Common::AlignUp(dir_ctx.path_len - dir_ctx.cur_path_ofs, 4);
+    dir_ctx.parent = parent;
+    directories.push_back(std::move(dir_ctx));
 
-    return true;
+    return static_cast<u32>(directories.size() - 1);
 }
 
-bool RomFSBuildContext::AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                std::shared_ptr<RomFSBuildFileContext> file_ctx) {
-    // Check whether it's already in the known files.
-    const auto existing = files.find(file_ctx->path);
-    if (existing != files.end()) {
-        return false;
-    }
-
-    // Add a new file.
-    num_files++;
+void RomFSBuildContext::AddFile(u32 parent, RomFSBuildFileContext file_ctx) {
     file_table_size +=
-        sizeof(RomFSFileEntry) + Common::AlignUp(file_ctx->path_len - file_ctx->cur_path_ofs, 4);
-    file_ctx->parent = parent_dir_ctx;
-    files.emplace(file_ctx->path, file_ctx);
-
-    return true;
+        sizeof(RomFSFileEntry) + Common::AlignUp(file_ctx.path_len - file_ctx.cur_path_ofs, 4);
+    file_ctx.parent = parent;
+    files.push_back(std::move(file_ctx));
 }
 
 RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
     : base(std::move(base_)), ext(std::move(ext_)) {
-    root = std::make_shared<RomFSBuildDirectoryContext>();
-    root->path = "\0";
-    directories.emplace(root->path, root);
-    num_dirs = 1;
+    directories.emplace_back();
     dir_table_size = 0x18;
 
-    VisitDirectory(base, ext, root);
+    VisitDirectory(base, ext, ROMFS_ROOT_INDEX);
 }
 
 RomFSBuildContext::~RomFSBuildContext() = default;
 
-std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
-    const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(num_dirs);
-    const u64 file_hash_table_entry_count = romfs_get_hash_table_count(num_files);
+RomFSBuildResult RomFSBuildContext::Build() {
+    const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(directories.size());
+    const u64 file_hash_table_entry_count = romfs_get_hash_table_count(files.size());
     dir_hash_table_size = 4 * dir_hash_table_entry_count;
     file_hash_table_size = 4 * file_hash_table_entry_count;
 
@@ -255,102 +276,133 @@ std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
     std::vector<u8> dir_table(dir_table_size);
     std::vector<u8> file_table(file_table_size);
 
-    std::shared_ptr<RomFSBuildFileContext> cur_file;
+    // Tables are laid out in path order, the root directory has the empty path and comes first.
+    const std::vector<u32> file_order = romfs_sort_by_path(files);
+    const std::vector<u32> dir_order = romfs_sort_by_path(directories);
 
     // Determine file offsets.
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildFileContext> prev_file = nullptr;
-    for (const auto& it : files) {
-        cur_file = it.second;
+    for (const u32 index : file_order) {
+        auto& cur_file = files[index];
         file_partition_size = Common::AlignUp(file_partition_size, 16);
-        cur_file->offset = file_partition_size;
-        file_partition_size += cur_file->size;
-        cur_file->entry_offset = entry_offset;
+        cur_file.offset = file_partition_size;
+        file_partition_size += cur_file.size;
+        cur_file.entry_offset = entry_offset;
         entry_offset +=
             static_cast<u32>(sizeof(RomFSFileEntry) +
-                             Common::AlignUp(cur_file->path_len - cur_file->cur_path_ofs, 4));
-        prev_file = cur_file;
+                             Common::AlignUp(cur_file.path_len - cur_file.cur_path_ofs, 4));
     }
     // Assign deferred parent/sibling ownership.
-    for (auto it = files.rbegin(); it != files.rend(); ++it) {
-        cur_file = it->second;
-        cur_file->sibling = cur_file->parent->file;
-        cur_file->parent->file = cur_file;
+    for (auto it = file_order.rbegin(); it != file_order.rend(); ++it) {
+        auto& cur_file = files[*it];
+        auto& parent = directories[cur_file.parent];
+        cur_file.sibling = parent.file;
+        parent.file = *it;
     }
 
-    std::shared_ptr<RomFSBuildDirectoryContext> cur_dir;
-
     // Determine directory offsets.
     entry_offset = 0;
-    for (const auto& it : directories) {
-        cur_dir = it.second;
-        cur_dir->entry_offset = entry_offset;
+    for (const u32 index : dir_order) {
+        auto& cur_dir = directories[index];
+        cur_dir.entry_offset = entry_offset;
         entry_offset +=
             static_cast<u32>(sizeof(RomFSDirectoryEntry) +
-                             Common::AlignUp(cur_dir->path_len - cur_dir->cur_path_ofs, 4));
+                             Common::AlignUp(cur_dir.path_len - cur_dir.cur_path_ofs, 4));
     }
     // Assign deferred parent/sibling ownership.
-    for (auto it = directories.rbegin(); it->second != root; ++it) {
-        cur_dir = it->second;
-        cur_dir->sibling = cur_dir->parent->child;
-        cur_dir->parent->child = cur_dir;
+    for (auto it = dir_order.rbegin(); it != dir_order.rend(); ++it) {
+        if (*it == ROMFS_ROOT_INDEX) {
+            continue;
+        }
+        auto& cur_dir = directories[*it];
+        auto& parent = directories[cur_dir.parent];
+        cur_dir.sibling = parent.child;
+        parent.child = *it;
     }
 
-    std::multimap<u64, VirtualFile> out;
-
-    // Populate file tables.
-    for (const auto& it : files) {
-        cur_file = it.second;
+    // Populate file tables. Every entry is written to its own offset, so they are serialized in
+    // parallel, only the hash chains are linked sequentially afterwards.
+    std::vector<u32> file_hashes(file_order.size());
+    romfs_parallel_for(file_order.size(), [&](std::size_t i) {
+        const auto& cur_file = files[file_order[i]];
+        const auto& parent = directories[cur_file.parent];
         RomFSFileEntry cur_entry{};
 
-        cur_entry.parent = cur_file->parent->entry_offset;
-        cur_entry.sibling =
-            cur_file->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_file->sibling->entry_offset;
-        cur_entry.offset = cur_file->offset;
-        cur_entry.size = cur_file->size;
-
-        const auto name_size = cur_file->path_len - cur_file->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_file->parent->entry_offset, cur_file->path,
-                                               cur_file->cur_path_ofs, name_size);
-        cur_entry.hash = file_hash_table[hash % file_hash_table_entry_count];
-        file_hash_table[hash % file_hash_table_entry_count] = cur_file->entry_offset;
-
+        cur_entry.parent = parent.entry_offset;
+        cur_entry.sibling = cur_file.sibling == ROMFS_ENTRY_EMPTY
+                                ? ROMFS_ENTRY_EMPTY
+                                : files[cur_file.sibling].entry_offset;
+        cur_entry.offset = cur_file.offset;
+        cur_entry.size = cur_file.size;
+
+        const auto name_size = cur_file.path_len - cur_file.cur_path_ofs;
+        file_hashes[i] = romfs_calc_path_hash(parent.entry_offset, cur_file.path,
+                                              cur_file.cur_path_ofs, name_size);
+        cur_entry.hash = ROMFS_ENTRY_EMPTY;
         cur_entry.name_size = name_size;
 
-        out.emplace(cur_file->offset + ROMFS_FILEPARTITION_OFS, cur_file->source);
-        std::memcpy(file_table.data() + cur_file->entry_offset, &cur_entry, sizeof(RomFSFileEntry));
-        std::memset(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry), 0,
-                    Common::AlignUp(cur_entry.name_size, 4));
-        std::memcpy(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry),
-                    cur_file->path.data() + cur_file->cur_path_ofs, name_size);
+        // The table is zero initialized, which pads the names
+        std::memcpy(file_table.data() + cur_file.entry_offset, &cur_entry, sizeof(RomFSFileEntry));
+        std::memcpy(file_table.data() + cur_file.entry_offset + sizeof(RomFSFileEntry),
+                    cur_file.path.data() + cur_file.cur_path_ofs, name_size);
+    });
+    for (std::size_t i = 0; i < file_order.size(); ++i) {
+        const u32 cur_entry_offset = files[file_order[i]].entry_offset;
+        u32& bucket = file_hash_table[file_hashes[i] % file_hash_table_entry_count];
+        std::memcpy(file_table.data() + cur_entry_offset + offsetof(RomFSFileEntry, hash), &bucket,
+                    sizeof(u32));
+        bucket = cur_entry_offset;
     }
 
     // Populate dir tables.
-    for (const auto& it : directories) {
-        cur_dir = it.second;
+    std::vector<u32> dir_hashes(dir_order.size());
+    romfs_parallel_for(dir_order.size(), [&](std::size_t i) {
+        const u32 index = dir_order[i];
+        const auto& cur_dir = directories[index];
+        const bool is_root = index == ROMFS_ROOT_INDEX;
+        const u32 parent_offset = is_root ? 0 : directories[cur_dir.parent].entry_offset;
         RomFSDirectoryEntry cur_entry{};
 
-        cur_entry.parent = cur_dir == root ? 0 : cur_dir->parent->entry_offset;
-        cur_entry.sibling =
-            cur_dir->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->sibling->entry_offset;
-        cur_entry.child =
-            cur_dir->child == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->child->entry_offset;
-        cur_entry.file = cur_dir->file == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->file->entry_offset;
-
-        const auto name_size = cur_dir->path_len - cur_dir->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_dir == root ? 0 : cur_dir->parent->entry_offset,
-                                               cur_dir->path, cur_dir->cur_path_ofs, name_size);
-        cur_entry.hash = dir_hash_table[hash % dir_hash_table_entry_count];
-        dir_hash_table[hash % dir_hash_table_entry_count] = cur_dir->entry_offset;
-
+        cur_entry.parent = parent_offset;
+        cur_entry.sibling = cur_dir.sibling == ROMFS_ENTRY_EMPTY
+                                ? ROMFS_ENTRY_EMPTY
+                                : directories[cur_dir.sibling].entry_offset;
+        cur_entry.child = cur_dir.child == ROMFS_ENTRY_EMPTY
+                              ? ROMFS_ENTRY_EMPTY
+                              : directories[cur_dir.child].entry_offset;
+        cur_entry.file = cur_dir.file == ROMFS_ENTRY_EMPTY ? ROMFS_ENTRY_EMPTY
+                                                           : files[cur_dir.file].entry_offset;
+
+        const auto name_size = cur_dir.path_len - cur_dir.cur_path_ofs;
+        dir_hashes[i] =
+            romfs_calc_path_hash(parent_offset, cur_dir.path, cur_dir.cur_path_ofs, name_size);
+        cur_entry.hash = ROMFS_ENTRY_EMPTY;
         cur_entry.name_size = name_size;
 
-        std::memcpy(dir_table.data() + cur_dir->entry_offset, &cur_entry,
+        std::memcpy(dir_table.data() + cur_dir.entry_offset, &cur_entry,
                     sizeof(RomFSDirectoryEntry));
-        std::memset(dir_table.data() + cur_dir->entry_offset + sizeof(RomFSDirectoryEntry), 0,
-                    Common::AlignUp(cur_entry.name_size, 4));
-        std::memcpy(dir_table.data() + cur_dir->entry_offset + sizeof(RomFSDirectoryEntry),
-                    cur_dir->path.data() + cur_dir->cur_path_ofs, name_size);
+        std::memcpy(dir_table.data() + cur_dir.entry_offset + sizeof(RomFSDirectoryEntry),
+                    cur_dir.path.data() + cur_dir.cur_path_ofs, name_size);
+    });
+    for (std::size_t i = 0; i < dir_order.size(); ++i) {
+        const u32 cur_entry_offset = directories[dir_order[i]].entry_offset;
+        u32& bucket = dir_hash_table[dir_hashes[i] % dir_hash_table_entry_count];
+        std::memcpy(dir_table.data() + cur_entry_offset + offsetof(RomFSDirectoryEntry, hash),
+                    &bucket, sizeof(u32));
+        bucket = cur_entry_offset;
+    }
+
+    RomFSBuildResult out;
+    out.files.reserve(file_order.size());
+    for (const u32 index : file_order) {
+        auto& cur_file = files[index];
+        out.files.push_back({
+            .path = std::move(cur_file.path),
+            .offset = cur_file.offset + ROMFS_FILEPARTITION_OFS,
+            .size = cur_file.size,
+            .ips_patched = cur_file.ips_patched,
+            .source = std::move(cur_file.source),
+        });
     }
 
     // Set header fields.
@@ -365,9 +417,8 @@ std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
     header.file_hash_table_ofs = header.dir_table_ofs + header.dir_table_size;
     header.file_table_ofs = header.file_hash_table_ofs + header.file_hash_table_size;
 
-    std::vector<u8> header_data(sizeof(RomFSHeader));
-    std::memcpy(header_data.data(), &header, header_data.size());
-    out.emplace(0, std::make_shared<VectorVfsFile>(std::move(header_data)));
+    out.header.resize(sizeof(RomFSHeader));
+    std::memcpy(out.header.data(), &header, out.header.size());
 
     std::vector<u8> metadata(file_hash_table_size + file_table_size + dir_hash_table_size +
                              dir_table_size);
@@ -380,8 +431,20 @@ std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
                 file_hash_table.size() * sizeof(u32));
     index += file_hash_table.size() * sizeof(u32);
     std::memcpy(metadata.data() + index, file_table.data(), file_table.size());
-    out.emplace(header.dir_hash_table_ofs, std::make_shared<VectorVfsFile>(std::move(metadata)));
+    out.metadata_offset = header.dir_hash_table_ofs;
+    out.metadata = std::move(metadata);
+
+    return out;
+}
 
+std::multimap<u64, VirtualFile> MakeRomFSParts(RomFSBuildResult result) {
+    std::multimap<u64, VirtualFile> out;
+    for (auto& file : result.files) {
+        out.emplace(file.offset, std::move(file.source));
+    }
+    out.emplace(0, std::make_shared<VectorVfsFile>(std::move(result.header)));
+    out.emplace(result.metadata_offset,
+                std::make_shared<VectorVfsFile>(std::move(result.metadata)));
     return out;
 }
 
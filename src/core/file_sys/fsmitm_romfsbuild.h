@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -37,35 +38,49 @@ struct RomFSBuildFileContext;
 struct RomFSDirectoryEntry;
 struct RomFSFileEntry;
 
+// File placed in the data partition of a built RomFS.
+struct RomFSBuildFile {
+    std::string path;
+    u64 offset = 0;
+    u64 size = 0;
+    bool ips_patched = false;
+    VirtualFile source;
+};
+
+// Output of a RomFS build: its header, its metadata tables and the placement of every file.
+struct RomFSBuildResult {
+    std::vector<u8> header;
+    u64 metadata_offset = 0;
+    std::vector<u8> metadata;
+    std::vector<RomFSBuildFile> files;
+};
+
 class RomFSBuildContext {
 public:
     explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
     ~RomFSBuildContext();
 
     // This finalizes the context.
-    std::multimap<u64, VirtualFile> Build();
+    RomFSBuildResult Build();
 
 private:
     VirtualDir base;
     VirtualDir ext;
-    std::shared_ptr<RomFSBuildDirectoryContext> root;
-    std::map<std::string, std::shared_ptr<RomFSBuildDirectoryContext>, std::less<>> directories;
-    std::map<std::string, std::shared_ptr<RomFSBuildFileContext>, std::less<>> files;
-    u64 num_dirs = 0;
-    u64 num_files = 0;
+    std::vector<RomFSBuildDirectoryContext> directories;
+    std::vector<RomFSBuildFileContext> files;
     u64 dir_table_size = 0;
     u64 file_table_size = 0;
     u64 dir_hash_table_size = 0;
     u64 file_hash_table_size = 0;
     u64 file_partition_size = 0;
 
-    void VisitDirectory(VirtualDir filesys, VirtualDir ext,
-                        std::shared_ptr<RomFSBuildDirectoryContext> parent);
+    void VisitDirectory(VirtualDir filesys, VirtualDir ext, u32 parent);
 
-    bool AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                      std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx);
-    bool AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                 std::shared_ptr<RomFSBuildFileContext> file_ctx);
+    u32 AddDirectory(u32 parent, RomFSBuildDirectoryContext dir_ctx);
+    void AddFile(u32 parent, RomFSBuildFileContext file_ctx);
 };
 
+// Converts the output of a build into the parts of the RomFS binary, keyed by their offset.
+std::multimap<u64, VirtualFile> MakeRomFSParts(RomFSBuildResult result);
+
 } // namespace FileSys
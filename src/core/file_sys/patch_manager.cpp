@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <cstring>
 
+#include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
@@ -19,6 +20,7 @@
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs.h"
+#include "core/file_sys/romfs_cache.h"
 #include "core/file_sys/vfs_layered.h"
 #include "core/file_sys/vfs_vector.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -384,6 +386,13 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         return;
     }
 
+    std::vector<VirtualDir> mod_layers = layers;
+    mod_layers.insert(mod_layers.end(), layers_ext.begin(), layers_ext.end());
+    RomFSCache cache{fmt::format("{}romfs" DIR_SEP "{:016X}_{:02X}.bin",
+                                 Common::FS::GetUserPath(Common::FS::UserPath::CacheDir), title_id,
+                                 static_cast<u8>(type)),
+                     romfs, mod_layers};
+
     layers.push_back(std::move(extracted));
 
     auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
@@ -393,7 +402,7 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
 
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    auto packed = cache.CreateRomFS(std::move(layered), std::move(layered_ext));
     if (packed == nullptr) {
         return;
     }
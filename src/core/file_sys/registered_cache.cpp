@@ -3,8 +3,12 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <random>
 #include <regex>
+#include <thread>
 #include <mbedtls/sha256.h>
 #include "common/assert.h"
 #include "common/file_util.h"
@@ -24,6 +28,9 @@ namespace FileSys {
 // The size of blocks to use when vfs raw copying into nand.
 constexpr size_t VFS_RC_LARGE_COPY_BLOCK = 0x400000;
 
+// The maximum number of NCAs of a single NSP copied at the same time.
+constexpr size_t MAX_PARALLEL_NCA_COPIES = 4;
+
 std::string ContentProviderEntry::DebugInfo() const {
     return fmt::format("title_id={:016X}, content_type={:02X}", title_id, static_cast<u8>(type));
 }
@@ -539,6 +546,117 @@ std::vector<ContentProviderEntry> RegisteredCache::ListEntriesFilter(
     return out;
 }
 
+// Read-only view of a file that hashes its contents while they are read front to back. Copy
+// functions read their source in order, so an NCA is hashed during its copy instead of in a second
+// pass over the installed file.
+class StreamHashingVfsFile final : public VfsFile {
+public:
+    explicit StreamHashingVfsFile(VirtualFile file_) : file{std::move(file_)} {
+        mbedtls_sha256_init(&context);
+        mbedtls_sha256_starts_ret(&context, 0);
+    }
+
+    ~StreamHashingVfsFile() override {
+        mbedtls_sha256_free(&context);
+    }
+
+    std::string GetName() const override {
+        return file->GetName();
+    }
+
+    std::size_t GetSize() const override {
+        return file->GetSize();
+    }
+
+    bool Resize(std::size_t new_size) override {
+        return false;
+    }
+
+    VirtualDir GetContainingDirectory() const override {
+        return file->GetContainingDirectory();
+    }
+
+    bool IsWritable() const override {
+        return false;
+    }
+
+    bool IsReadable() const override {
+        return file->IsReadable();
+    }
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        const std::size_t read = file->Read(data, length, offset);
+
+        std::scoped_lock lock{mutex};
+        if (offset != hashed_size) {
+            sequential = false;
+        } else if (sequential) {
+            mbedtls_sha256_update_ret(&context, data, read);
+            hashed_size += read;
+        }
+        return read;
+    }
+
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override {
+        return 0;
+    }
+
+    bool Rename(std::string_view name) override {
+        return false;
+    }
+
+    /// Returns the hash of the file, or std::nullopt if it was not read entirely and in order.
+    std::optional<Core::Crypto::SHA256Hash> Finish() {
+        std::scoped_lock lock{mutex};
+        if (!sequential || hashed_size != file->GetSize()) {
+            return std::nullopt;
+        }
+        Core::Crypto::SHA256Hash hash{};
+        mbedtls_sha256_finish_ret(&context, hash.data());
+        sequential = false;
+        return hash;
+    }
+
+private:
+    VirtualFile file;
+
+    mutable std::mutex mutex;
+    mutable mbedtls_sha256_context context;
+    mutable std::size_t hashed_size = 0;
+    mutable bool sequential = true;
+};
+
+// Copies an NCA to out and logs the throughput. When expected_hash is set, the NCA is checked
+// against it while it is copied.
+static bool CopyNCA(const NCA& nca, const VirtualFile& out, const VfsCopyFunction& copy,
+                    const std::optional<Core::Crypto::SHA256Hash>& expected_hash) {
+    const auto in = nca.GetBaseFile();
+    const auto hashing_in = expected_hash ? std::make_shared<StreamHashingVfsFile>(in) : nullptr;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!copy(hashing_in != nullptr ? hashing_in : in, out, VFS_RC_LARGE_COPY_BLOCK)) {
+        return false;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double mib = static_cast<double>(in->GetSize()) / (1024.0 * 1024.0);
+    LOG_INFO(Loader, "Installed {} ({:.1f} MiB at {:.1f} MiB/s)", out->GetName(), mib,
+             elapsed.count() > 0.0 ? mib / elapsed.count() : 0.0);
+
+    if (hashing_in == nullptr) {
+        return true;
+    }
+    const auto hash = hashing_in->Finish();
+    if (!hash) {
+        LOG_DEBUG(Loader, "{} was not read in order while copying, skipping verification",
+                  out->GetName());
+    } else if (*hash != *expected_hash) {
+        // Converted dumps legitimately modify NCA headers, so a mismatch is only reported
+        LOG_WARNING(Loader, "{} does not match the hash recorded in its metadata",
+                    out->GetName());
+    }
+    return true;
+}
+
 static std::shared_ptr<NCA> GetNCAFromNSPForID(const NSP& nsp, const NcaID& id) {
     auto file = nsp.GetFile(fmt::format("{}.nca", Common::HexToString(id, false)));
     if (file == nullptr) {
@@ -596,20 +714,51 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         return res;
     }
 
-    // Install all the other NCAs
+    // Install all the other NCAs. Their files are created first, as the host filesystem is not
+    // safe to modify from several threads, then the NCAs are copied in parallel.
+    struct PendingNCA {
+        std::shared_ptr<NCA> nca;
+        VirtualFile out;
+        Core::Crypto::SHA256Hash hash;
+    };
+    std::vector<PendingNCA> pending;
     for (const auto& record : cnmt.GetContentRecords()) {
         // Ignore DeltaFragments, they are not useful to us
         if (record.type == ContentRecordType::DeltaFragment) {
             continue;
         }
-        const auto nca = GetNCAFromNSPForID(nsp, record.nca_id);
+        auto nca = GetNCAFromNSPForID(nsp, record.nca_id);
         if (nca == nullptr) {
             return InstallResult::ErrorCopyFailed;
         }
-        const auto res2 = RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id);
+        VirtualFile out;
+        const auto res2 = PrepareInstallNCA(*nca, overwrite_if_exists, record.nca_id, out);
         if (res2 != InstallResult::Success) {
             return res2;
         }
+        pending.push_back({std::move(nca), std::move(out), record.hash});
+    }
+
+    std::atomic<std::size_t> next_nca{0};
+    std::atomic<bool> copied{true};
+    const auto copy_worker = [&] {
+        for (std::size_t i; (i = next_nca++) < pending.size();) {
+            if (!CopyNCA(*pending[i].nca, pending[i].out, copy, pending[i].hash)) {
+                copied = false;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    const std::size_t num_threads = std::min(pending.size(), MAX_PARALLEL_NCA_COPIES);
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(copy_worker);
+    }
+    copy_worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (!copied) {
+        return InstallResult::ErrorCopyFailed;
     }
 
     Refresh();
@@ -701,6 +850,18 @@ bool RegisteredCache::RemoveExistingEntry(u64 title_id) const {
 InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                              bool overwrite_if_exists,
                                              std::optional<NcaID> override_id) {
+    VirtualFile out;
+    const auto res = PrepareInstallNCA(nca, overwrite_if_exists, override_id, out);
+    if (res != InstallResult::Success) {
+        return res;
+    }
+    return CopyNCA(nca, out, copy, std::nullopt) ? InstallResult::Success
+                                                 : InstallResult::ErrorCopyFailed;
+}
+
+InstallResult RegisteredCache::PrepareInstallNCA(const NCA& nca, bool overwrite_if_exists,
+                                                 std::optional<NcaID> override_id,
+                                                 VirtualFile& out) {
     const auto in = nca.GetBaseFile();
     Core::Crypto::SHA256Hash hash{};
 
@@ -731,12 +892,11 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
         c_dir->DeleteFile(Common::FS::GetFilename(path));
     }
 
-    auto out = dir->CreateFileRelative(path);
+    out = dir->CreateFileRelative(path);
     if (out == nullptr) {
         return InstallResult::ErrorCopyFailed;
     }
-    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
-                                                  : InstallResult::ErrorCopyFailed;
+    return InstallResult::Success;
 }
 
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
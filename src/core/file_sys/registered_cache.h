@@ -158,16 +158,16 @@ public:
     // Raw copies all the ncas from the xci/nsp to the csache. Does some quick checks to make sure
     // there is a meta NCA and all of them are accessible.
     InstallResult InstallEntry(const XCI& xci, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const VfsCopyFunction& copy = &VfsPipelinedCopy);
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const VfsCopyFunction& copy = &VfsPipelinedCopy);
 
     // Due to the fact that we must use Meta-type NCAs to determine the existance of files, this
     // poses quite a challenge. Instead of creating a new meta NCA for this file, yuzu will create a
     // dir inside the NAND called 'yuzu_meta' and store the raw CNMT there.
     // TODO(DarkLordZach): Author real meta-type NCAs and install those.
     InstallResult InstallEntry(const NCA& nca, TitleType type, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const VfsCopyFunction& copy = &VfsPipelinedCopy);
 
     // Removes an existing entry based on title id
     bool RemoveExistingEntry(u64 title_id) const;
@@ -185,6 +185,9 @@ private:
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& dir, std::string_view path) const;
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+    // Checks whether an NCA can be installed and creates the file it is copied to in out.
+    InstallResult PrepareInstallNCA(const NCA& nca, bool overwrite_if_exists,
+                                    std::optional<NcaID> override_id, VirtualFile& out);
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
     VirtualDir dir;
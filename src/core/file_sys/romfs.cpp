@@ -2,8 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/string_util.h"
 #include "common/swap.h"
@@ -136,12 +141,39 @@ VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
     return out;
 }
 
+std::optional<u64> HashRomFSMetadata(const VirtualFile& file) {
+    RomFSHeader header{};
+    if (file->ReadObject(&header) != sizeof(RomFSHeader))
+        return std::nullopt;
+
+    if (header.header_size != sizeof(RomFSHeader))
+        return std::nullopt;
+
+    // The tables hold the name, size and offset of every entry, which fully describe the layout
+    std::vector<u8> metadata(sizeof(RomFSHeader));
+    std::memcpy(metadata.data(), &header, sizeof(RomFSHeader));
+    const std::array tables{header.directory_hash, header.directory_meta, header.file_hash,
+                            header.file_meta};
+    for (const TableLocation& table : tables) {
+        if (table.offset + table.size > file->GetSize())
+            return std::nullopt;
+
+        const std::size_t table_offset = metadata.size();
+        metadata.resize(table_offset + table.size);
+        if (file->Read(metadata.data() + table_offset, table.size, table.offset) != table.size)
+            return std::nullopt;
+    }
+
+    return Common::CityHash64(reinterpret_cast<const char*>(metadata.data()), metadata.size());
+}
+
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
     if (dir == nullptr)
         return nullptr;
 
     RomFSBuildContext ctx{dir, ext};
-    return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), dir->GetName());
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, MakeRomFSParts(ctx.Build()),
+                                                     dir->GetName());
 }
 
 } // namespace FileSys
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+#include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -19,6 +21,10 @@ enum class RomFSExtractionType {
 VirtualDir ExtractRomFS(VirtualFile file,
                         RomFSExtractionType type = RomFSExtractionType::Truncated);
 
+// Hashes the header and metadata tables of a RomFS binary, which identify its layout
+// Returns std::nullopt on failure
+std::optional<u64> HashRomFSMetadata(const VirtualFile& file);
+
 // Converts a VFS filesystem into a RomFS binary
 // Returns nullptr on failure
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr);
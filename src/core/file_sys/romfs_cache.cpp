@@ -0,0 +1,276 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "common/cityhash.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
+#include "core/file_sys/ips_layer.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/romfs_cache.h"
+#include "core/file_sys/vfs_concat.h"
+
+namespace FileSys {
+namespace {
+constexpr u32 CACHE_MAGIC = 0x53465252; // RRFS
+constexpr u32 CACHE_VERSION = 1;
+
+struct CacheHeader {
+    u32 magic;
+    u32 version;
+    u64 key;
+    u64 header_size;
+    u64 metadata_offset;
+    u64 metadata_size;
+    u64 num_files;
+};
+static_assert(std::is_trivially_copyable_v<CacheHeader>);
+
+struct CacheFileEntry {
+    u64 offset;
+    u64 size;
+    u32 path_size;
+    u32 ips_patched;
+};
+static_assert(std::is_trivially_copyable_v<CacheFileEntry>);
+
+template <typename T>
+void Append(std::vector<u8>& buffer, const T& object) {
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &object, sizeof(T));
+}
+
+void AppendBytes(std::vector<u8>& buffer, const void* data, std::size_t size) {
+    const auto* const bytes = static_cast<const u8*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+/// Reads objects from a loaded cache file, failing once it runs past its end
+class CacheReader {
+public:
+    explicit CacheReader(const std::vector<u8>& buffer_) : buffer{buffer_} {}
+
+    template <typename T>
+    bool Read(T& object) {
+        return ReadBytes(&object, sizeof(T));
+    }
+
+    bool ReadBytes(void* data, std::size_t size) {
+        if (size > buffer.size() - position) {
+            return false;
+        }
+        std::memcpy(data, buffer.data() + position, size);
+        position += size;
+        return true;
+    }
+
+private:
+    const std::vector<u8>& buffer;
+    std::size_t position = 0;
+};
+
+/// Appends the path, size and modification time of every file below directory, in a stable order
+void AppendDirectoryState(std::vector<u8>& buffer, const std::string& directory) {
+    std::vector<std::string> names;
+    Common::FS::ForeachDirectoryEntry(
+        nullptr, directory,
+        [&names](u64*, const std::string&, const std::string& filename) {
+            names.push_back(filename);
+            return true;
+        });
+    std::sort(names.begin(), names.end());
+
+    for (const std::string& name : names) {
+        const std::string full_path = directory + '/' + name;
+        AppendBytes(buffer, name.data(), name.size() + 1);
+        if (Common::FS::IsDirectory(full_path)) {
+            AppendDirectoryState(buffer, full_path);
+            Append(buffer, u8{0});
+            continue;
+        }
+        Append(buffer, Common::FS::GetSize(full_path));
+        Append(buffer, Common::FS::GetModificationTime(full_path));
+    }
+}
+
+std::optional<u64> ComputeKey(const VirtualFile& base, const std::vector<VirtualDir>& layers) {
+    const std::optional<u64> base_hash = HashRomFSMetadata(base);
+    if (!base_hash) {
+        return std::nullopt;
+    }
+
+    std::vector<u8> state;
+    Append(state, CACHE_VERSION);
+    Append(state, *base_hash);
+    for (const auto& layer : layers) {
+        // Only mods on the host filesystem can be checked for changes
+        const std::string layer_path = layer->GetFullPath();
+        if (!Common::FS::IsDirectory(layer_path)) {
+            return std::nullopt;
+        }
+        AppendBytes(state, layer_path.data(), layer_path.size() + 1);
+        AppendDirectoryState(state, layer_path);
+    }
+    return Common::CityHash64(reinterpret_cast<const char*>(state.data()), state.size());
+}
+
+/// Opens the source of every file of a cached build, returns false if one of them changed
+bool OpenSources(RomFSBuildResult& result, const VirtualDir& dir, const VirtualDir& ext) {
+    for (auto& file : result.files) {
+        file.source = dir->GetFileRelative(file.path);
+        if (file.source == nullptr) {
+            return false;
+        }
+        if (file.ips_patched) {
+            const auto ips = ext != nullptr ? ext->GetFileRelative(file.path + ".ips") : nullptr;
+            if (ips == nullptr) {
+                return false;
+            }
+            file.source = PatchIPS(file.source, ips);
+            if (file.source == nullptr) {
+                return false;
+            }
+        }
+        if (file.source->GetSize() != file.size) {
+            return false;
+        }
+    }
+    return true;
+}
+} // Anonymous namespace
+
+RomFSCache::RomFSCache(std::string path_, const VirtualFile& base,
+                       const std::vector<VirtualDir>& layers)
+    : path{std::move(path_)}, key{ComputeKey(base, layers)} {}
+
+RomFSCache::~RomFSCache() = default;
+
+VirtualFile RomFSCache::CreateRomFS(VirtualDir dir, VirtualDir ext) {
+    if (dir == nullptr) {
+        return nullptr;
+    }
+
+    std::optional<RomFSBuildResult> result = Load();
+    if (result && !OpenSources(*result, dir, ext)) {
+        LOG_WARNING(Loader, "Cached RomFS at {} does not match its layers, rebuilding", path);
+        result.reset();
+    }
+    if (!result) {
+        RomFSBuildContext ctx{dir, ext};
+        result = ctx.Build();
+        Save(*result);
+    } else {
+        LOG_INFO(Loader, "Loaded RomFS metadata of {} files from cache", result->files.size());
+    }
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, MakeRomFSParts(std::move(*result)),
+                                                     dir->GetName());
+}
+
+std::optional<RomFSBuildResult> RomFSCache::Load() const {
+    if (!key || !Common::FS::Exists(path)) {
+        return std::nullopt;
+    }
+
+    Common::FS::IOFile file(path, "rb");
+    if (!file.IsOpen()) {
+        return std::nullopt;
+    }
+    std::vector<u8> buffer(file.GetSize());
+    if (file.ReadBytes(buffer.data(), buffer.size()) != buffer.size()) {
+        return std::nullopt;
+    }
+
+    CacheReader reader{buffer};
+    CacheHeader header{};
+    if (!reader.Read(header) || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+        header.key != *key) {
+        return std::nullopt;
+    }
+    // Sizes are checked against the file before allocating anything
+    if (header.header_size > buffer.size() ||
+        header.metadata_size > buffer.size() - header.header_size ||
+        header.num_files > buffer.size() / sizeof(CacheFileEntry)) {
+        return std::nullopt;
+    }
+
+    RomFSBuildResult result;
+    result.header.resize(header.header_size);
+    result.metadata_offset = header.metadata_offset;
+    result.metadata.resize(header.metadata_size);
+    if (!reader.ReadBytes(result.header.data(), result.header.size()) ||
+        !reader.ReadBytes(result.metadata.data(), result.metadata.size())) {
+        return std::nullopt;
+    }
+
+    result.files.resize(header.num_files);
+    for (auto& file : result.files) {
+        CacheFileEntry entry{};
+        if (!reader.Read(entry) || entry.path_size > buffer.size()) {
+            return std::nullopt;
+        }
+        file.path.resize(entry.path_size);
+        if (!reader.ReadBytes(file.path.data(), file.path.size())) {
+            return std::nullopt;
+        }
+        file.offset = entry.offset;
+        file.size = entry.size;
+        file.ips_patched = entry.ips_patched != 0;
+    }
+    return result;
+}
+
+void RomFSCache::Save(const RomFSBuildResult& result) const {
+    if (!key) {
+        return;
+    }
+
+    std::vector<u8> buffer;
+    Append(buffer, CacheHeader{
+                       .magic = CACHE_MAGIC,
+                       .version = CACHE_VERSION,
+                       .key = *key,
+                       .header_size = result.header.size(),
+                       .metadata_offset = result.metadata_offset,
+                       .metadata_size = result.metadata.size(),
+                       .num_files = result.files.size(),
+                   });
+    AppendBytes(buffer, result.header.data(), result.header.size());
+    AppendBytes(buffer, result.metadata.data(), result.metadata.size());
+    for (const auto& file : result.files) {
+        Append(buffer, CacheFileEntry{
+                           .offset = file.offset,
+                           .size = file.size,
+                           .path_size = static_cast<u32>(file.path.size()),
+                           .ips_patched = file.ips_patched ? 1U : 0U,
+                       });
+        AppendBytes(buffer, file.path.data(), file.path.size());
+    }
+
+    // Written aside first so an interrupted write never leaves a truncated cache behind
+    const std::string temp_path = path + ".tmp";
+    if (!Common::FS::CreateFullPath(path)) {
+        return;
+    }
+    {
+        Common::FS::IOFile file(temp_path, "wb");
+        if (!file.IsOpen() || file.WriteBytes(buffer.data(), buffer.size()) != buffer.size()) {
+            LOG_ERROR(Loader, "Failed to write RomFS cache to {}", temp_path);
+            return;
+        }
+    }
+    if (Common::FS::Exists(path)) {
+        Common::FS::Delete(path);
+    }
+    if (!Common::FS::Rename(temp_path, path)) {
+        LOG_ERROR(Loader, "Failed to move RomFS cache to {}", path);
+    }
+}
+
+} // namespace FileSys
@@ -0,0 +1,54 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+struct RomFSBuildResult;
+
+/**
+ * Keeps the metadata of a RomFS rebuilt by LayeredFS on disk.
+ *
+ * A cached build is reused as long as the layout of the base RomFS and the files of every mod
+ * layer did not change, files are then opened directly by path instead of walking and merging
+ * the whole tree again. Only the metadata is cached, file contents are always read from the
+ * layers.
+ */
+class RomFSCache {
+public:
+    /**
+     * Creates the cache of the RomFS built from base with the given mod layers.
+     * @param path_  Path of the cache file on the host filesystem.
+     * @param base   RomFS binary the mods are applied over.
+     * @param layers Every mod directory used by the build, romfs and romfs_ext, in order.
+     */
+    explicit RomFSCache(std::string path_, const VirtualFile& base,
+                        const std::vector<VirtualDir>& layers);
+    ~RomFSCache();
+
+    /// Builds a RomFS from dir and ext like CreateRomFS, reusing the cached metadata when valid.
+    VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext);
+
+private:
+    /// Loads the cached build, std::nullopt when it is missing or was built from other inputs
+    std::optional<RomFSBuildResult> Load() const;
+
+    /// Stores the metadata of a build
+    void Save(const RomFSBuildResult& result) const;
+
+    std::string path;
+
+    /// Hash of every input of the build, std::nullopt when they can't be identified
+    std::optional<u64> key;
+};
+
+} // namespace FileSys
@@ -3,8 +3,12 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
 #include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/logging/backend.h"
@@ -532,6 +536,92 @@ bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t blo
     return true;
 }
 
+bool VfsPipelinedCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size) {
+    return VfsPipelinedCopyWithProgress(src, dest, block_size, {});
+}
+
+bool VfsPipelinedCopyWithProgress(const VirtualFile& src, const VirtualFile& dest,
+                                  std::size_t block_size, const VfsCopyProgressCallback& callback) {
+    if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
+        return false;
+    const std::size_t size = src->GetSize();
+    if (!dest->Resize(size))
+        return false;
+    if (size == 0)
+        return true;
+
+    // Enough buffers for the reader to stay ahead while a block is being written
+    constexpr std::size_t NUM_BUFFERS = 3;
+    block_size = std::min(block_size, size);
+    const std::size_t num_blocks = (size + block_size - 1) / block_size;
+    std::array<std::vector<u8>, NUM_BUFFERS> buffers;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t blocks_read = 0;
+    std::size_t blocks_written = 0;
+    bool read_failed = false;
+    bool write_stopped = false;
+
+    std::thread reader([&] {
+        for (std::size_t block = 0; block < num_blocks; ++block) {
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&] {
+                    return write_stopped || block - blocks_written < NUM_BUFFERS;
+                });
+                if (write_stopped) {
+                    return;
+                }
+            }
+            const std::size_t offset = block * block_size;
+            const std::size_t length = std::min(block_size, size - offset);
+            auto& buffer = buffers[block % NUM_BUFFERS];
+            buffer.resize(length);
+            const bool success = src->Read(buffer.data(), length, offset) == length;
+            {
+                std::scoped_lock lock{mutex};
+                if (success) {
+                    ++blocks_read;
+                } else {
+                    read_failed = true;
+                }
+            }
+            cv.notify_all();
+            if (!success) {
+                return;
+            }
+        }
+    });
+
+    bool success = true;
+    for (std::size_t block = 0; block < num_blocks && success; ++block) {
+        {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [&] { return read_failed || blocks_read > block; });
+            if (blocks_read <= block) {
+                success = false;
+                break;
+            }
+        }
+        const auto& buffer = buffers[block % NUM_BUFFERS];
+        const std::size_t offset = block * block_size;
+        success = dest->Write(buffer.data(), buffer.size(), offset) == buffer.size();
+        if (success && callback) {
+            success = callback(offset + buffer.size());
+        }
+        {
+            std::scoped_lock lock{mutex};
+            ++blocks_written;
+            write_stopped = !success;
+        }
+        cv.notify_all();
+    }
+    reader.join();
+
+    return success;
+}
+
 bool VfsRawCopyD(const VirtualDir& src, const VirtualDir& dest, std::size_t block_size) {
     if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
         return false;
@@ -302,6 +302,19 @@ bool DeepEquals(const VirtualFile& file1, const VirtualFile& file2,
 // directory of src/dest.
 bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size = 0x1000);
 
+// Callback of a pipelined copy, receives the number of bytes copied so far after each block is
+// written. Returning false aborts the copy.
+using VfsCopyProgressCallback = std::function<bool(std::size_t bytes_copied)>;
+
+// Same as VfsRawCopy, but blocks are read on a separate thread ahead of the one being written, so
+// reading the source overlaps with writing the destination. Meant for large files.
+bool VfsPipelinedCopy(const VirtualFile& src, const VirtualFile& dest,
+                      std::size_t block_size = 0x400000);
+
+// VfsPipelinedCopy reporting its progress to callback after each block.
+bool VfsPipelinedCopyWithProgress(const VirtualFile& src, const VirtualFile& dest,
+                                  std::size_t block_size, const VfsCopyProgressCallback& callback);
+
 // A method that performs a similar function to VfsRawCopy above, but instead copies entire
 // directories. It suffers the same performance penalties as above and an implementation-specific
 // Copy should always be preferred.
@@ -111,25 +111,27 @@ bool ConcatenatedVfsFile::IsReadable() const {
 }
 
 std::size_t ConcatenatedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    auto entry = --files.end();
-    for (auto iter = files.begin(); iter != files.end(); ++iter) {
-        if (iter->first > offset) {
-            entry = --iter;
+    std::size_t total_read = 0;
+    while (length > 0) {
+        // Last file starting at or before offset, LayeredFS images concatenate many thousands
+        auto entry = files.upper_bound(offset);
+        if (entry == files.begin()) {
             break;
         }
-    }
+        --entry;
 
-    if (entry->first + entry->second->GetSize() <= offset)
-        return 0;
+        const u64 entry_end = entry->first + entry->second->GetSize();
+        if (entry_end <= offset) {
+            break;
+        }
 
-    const auto read_in =
-        std::min<u64>(entry->first + entry->second->GetSize() - offset, entry->second->GetSize());
-    if (length > read_in) {
-        return entry->second->Read(data, read_in, offset - entry->first) +
-               Read(data + read_in, length - read_in, offset + read_in);
+        const auto read_in = static_cast<std::size_t>(std::min<u64>(entry_end - offset, length));
+        total_read += entry->second->Read(data, read_in, offset - entry->first);
+        data += read_in;
+        length -= read_in;
+        offset += read_in;
     }
-
-    return entry->second->Read(data, std::min<u64>(read_in, length), offset - entry->first);
+    return total_read;
 }
 
 std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
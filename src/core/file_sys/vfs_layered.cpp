@@ -3,13 +3,76 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include "core/file_sys/vfs_layered.h"
 
 namespace FileSys {
 
-LayeredVfsDirectory::LayeredVfsDirectory(std::vector<VirtualDir> dirs, std::string name)
-    : dirs(std::move(dirs)), name(std::move(name)) {}
+// Flattened view of every file and directory in a layer stack. Paths are stored as keys relative
+// to the root of the stack, mapped to the index of the layer that provides them.
+class LayeredVfsDirectory::PathIndex {
+public:
+    explicit PathIndex(std::vector<VirtualDir> layers_) : layers(std::move(layers_)) {}
+
+    /// Returns the file at key in the highest priority layer holding it, or nullptr.
+    VirtualFile GetFile(const std::string& key) {
+        std::call_once(build_flag, [this] { Build(); });
+        const auto it = files.find(key);
+        if (it == files.end()) {
+            return nullptr;
+        }
+        return layers[it->second]->GetFileRelative(key);
+    }
+
+    /// Returns the directory at key of every layer holding it, in priority order.
+    std::vector<VirtualDir> GetDirectories(const std::string& key) {
+        std::call_once(build_flag, [this] { Build(); });
+        const auto it = directories.find(key);
+        if (it == directories.end()) {
+            return {};
+        }
+        std::vector<VirtualDir> out;
+        out.reserve(it->second.size());
+        for (const std::size_t layer : it->second) {
+            auto dir = layers[layer]->GetDirectoryRelative(key);
+            if (dir != nullptr) {
+                out.push_back(std::move(dir));
+            }
+        }
+        return out;
+    }
+
+private:
+    void Build() {
+        for (std::size_t layer = 0; layer < layers.size(); ++layer) {
+            AddDirectory(layer, layers[layer], "");
+        }
+    }
+
+    void AddDirectory(std::size_t layer, const VirtualDir& dir, const std::string& path) {
+        for (const auto& file : dir->GetFiles()) {
+            // Files of lower priority layers are shadowed by the ones already inserted
+            files.try_emplace(path + file->GetName(), layer);
+        }
+        for (const auto& subdir : dir->GetSubdirectories()) {
+            const std::string subdir_path = path + subdir->GetName();
+            directories[subdir_path].push_back(layer);
+            AddDirectory(layer, subdir, subdir_path + '/');
+        }
+    }
+
+    std::vector<VirtualDir> layers;
+    std::once_flag build_flag;
+    std::unordered_map<std::string, std::size_t> files;
+    std::unordered_map<std::string, std::vector<std::size_t>> directories;
+};
+
+LayeredVfsDirectory::LayeredVfsDirectory(std::vector<VirtualDir> dirs, std::string name,
+                                         std::shared_ptr<PathIndex> index, std::string prefix)
+    : dirs(std::move(dirs)), name(std::move(name)), index(std::move(index)),
+      prefix(std::move(prefix)) {}
 
 LayeredVfsDirectory::~LayeredVfsDirectory() = default;
 
@@ -20,29 +83,50 @@ VirtualDir LayeredVfsDirectory::MakeLayeredDirectory(std::vector<VirtualDir> dir
     if (dirs.size() == 1)
         return dirs[0];
 
-    return VirtualDir(new LayeredVfsDirectory(std::move(dirs), std::move(name)));
+    auto index = std::make_shared<PathIndex>(dirs);
+    return VirtualDir(
+        new LayeredVfsDirectory(std::move(dirs), std::move(name), std::move(index), ""));
 }
 
-VirtualFile LayeredVfsDirectory::GetFileRelative(std::string_view path) const {
-    for (const auto& layer : dirs) {
-        const auto file = layer->GetFileRelative(path);
-        if (file != nullptr)
-            return file;
+std::string LayeredVfsDirectory::MakeIndexKey(std::string_view path) const {
+    std::string key;
+    std::size_t begin = 0;
+    while (begin < path.size()) {
+        std::size_t end = path.find_first_of("/\\", begin);
+        if (end == std::string_view::npos) {
+            end = path.size();
+        }
+        if (end != begin) {
+            key += key.empty() ? prefix : "/";
+            key += path.substr(begin, end - begin);
+        }
+        begin = end + 1;
     }
+    return key;
+}
 
-    return nullptr;
+VirtualFile LayeredVfsDirectory::GetFileRelative(std::string_view path) const {
+    const std::string key = MakeIndexKey(path);
+    if (key.empty()) {
+        return nullptr;
+    }
+    return index->GetFile(key);
 }
 
 VirtualDir LayeredVfsDirectory::GetDirectoryRelative(std::string_view path) const {
-    std::vector<VirtualDir> out;
-    for (const auto& layer : dirs) {
-        auto dir = layer->GetDirectoryRelative(path);
-        if (dir != nullptr) {
-            out.push_back(std::move(dir));
-        }
+    const std::string key = MakeIndexKey(path);
+    if (key.empty()) {
+        return nullptr;
+    }
+    auto out = index->GetDirectories(key);
+    if (out.empty()) {
+        return nullptr;
+    }
+    if (out.size() == 1) {
+        return out[0];
     }
 
-    return MakeLayeredDirectory(std::move(out));
+    return VirtualDir(new LayeredVfsDirectory(std::move(out), "", index, key + '/'));
 }
 
 VirtualFile LayeredVfsDirectory::GetFile(std::string_view name) const {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -12,8 +13,13 @@ namespace FileSys {
 // Class that stacks multiple VfsDirectories on top of each other, attempting to read from the first
 // one and falling back to the one after. The highest priority directory (overwrites all others)
 // should be element 0 in the dirs vector.
+// Lookups are resolved through a table of every path in the stack, built on first use and shared
+// by all subdirectories of the view, so their cost does not depend on the number of layers.
 class LayeredVfsDirectory : public VfsDirectory {
-    LayeredVfsDirectory(std::vector<VirtualDir> dirs, std::string name);
+    class PathIndex;
+
+    LayeredVfsDirectory(std::vector<VirtualDir> dirs, std::string name,
+                        std::shared_ptr<PathIndex> index, std::string prefix);
 
 public:
     ~LayeredVfsDirectory() override;
@@ -40,8 +46,14 @@ public:
     bool Rename(std::string_view name) override;
 
 private:
+    /// Converts a path relative to this directory into a key of the path index
+    std::string MakeIndexKey(std::string_view path) const;
+
     std::vector<VirtualDir> dirs;
     std::string name;
+
+    std::shared_ptr<PathIndex> index;
+    std::string prefix;
 };
 
 } // namespace FileSys
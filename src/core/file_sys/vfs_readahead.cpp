@@ -0,0 +1,207 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/file_sys/vfs_readahead.h"
+
+namespace FileSys {
+
+const std::vector<u8>& ReadaheadScheduler::Block::Wait() {
+    std::unique_lock lock{mutex};
+    cv.wait(lock, [this] { return ready; });
+    return data;
+}
+
+ReadaheadScheduler::ReadaheadScheduler(std::size_t num_threads, std::size_t capacity_bytes)
+    : capacity{capacity_bytes / BLOCK_SIZE}, workers{num_threads, "yuzu:FsReadahead"} {}
+
+ReadaheadScheduler::~ReadaheadScheduler() = default;
+
+VirtualFile ReadaheadScheduler::Wrap(VirtualFile file) {
+    if (file == nullptr || file->IsWritable()) {
+        return file;
+    }
+    return std::make_shared<ReadaheadVfsFile>(std::move(file), shared_from_this(),
+                                              next_stream_id.fetch_add(1));
+}
+
+std::size_t ReadaheadScheduler::NumCachedBlocks() {
+    std::scoped_lock lock{mutex};
+    return cache.size();
+}
+
+std::shared_ptr<ReadaheadScheduler::Block> ReadaheadScheduler::Find(u64 stream_id,
+                                                                    std::size_t index) {
+    std::scoped_lock lock{mutex};
+    const auto it = cache.find({stream_id, index});
+    if (it == cache.end()) {
+        return nullptr;
+    }
+    lru.splice(lru.end(), lru, it->second.lru_iterator);
+    return it->second.block;
+}
+
+void ReadaheadScheduler::Prefetch(u64 stream_id, const VirtualFile& file, std::size_t index) {
+    const std::size_t offset = index * BLOCK_SIZE;
+    const std::size_t file_size = file->GetSize();
+    if (offset >= file_size) {
+        return;
+    }
+    auto block = std::make_shared<Block>();
+    {
+        std::scoped_lock lock{mutex};
+        const BlockKey key{stream_id, index};
+        if (cache.contains(key)) {
+            return;
+        }
+        lru.push_back(key);
+        cache.emplace(key, CacheEntry{block, std::prev(lru.end())});
+        EvictOverCapacity();
+    }
+    const std::size_t size = std::min(BLOCK_SIZE, file_size - offset);
+    workers.QueueWork([block = std::move(block), file, offset, size] {
+        std::vector<u8> data(size);
+        data.resize(file->Read(data.data(), size, offset));
+        {
+            std::scoped_lock lock{block->mutex};
+            block->data = std::move(data);
+            block->ready = true;
+        }
+        block->cv.notify_all();
+    });
+}
+
+void ReadaheadScheduler::Forget(u64 stream_id) {
+    std::scoped_lock lock{mutex};
+    for (auto it = lru.begin(); it != lru.end();) {
+        if (it->first != stream_id) {
+            ++it;
+            continue;
+        }
+        cache.erase(*it);
+        it = lru.erase(it);
+    }
+}
+
+void ReadaheadScheduler::EvictOverCapacity() {
+    // Readers waiting on an evicted block keep it alive until it has been read
+    while (cache.size() > capacity && !lru.empty()) {
+        cache.erase(lru.front());
+        lru.pop_front();
+    }
+}
+
+ReadaheadVfsFile::ReadaheadVfsFile(VirtualFile file_,
+                                   std::shared_ptr<ReadaheadScheduler> scheduler_, u64 stream_id_)
+    : file{std::move(file_)}, scheduler{std::move(scheduler_)}, stream_id{stream_id_} {}
+
+ReadaheadVfsFile::~ReadaheadVfsFile() {
+    scheduler->Forget(stream_id);
+}
+
+std::string ReadaheadVfsFile::GetName() const {
+    return file->GetName();
+}
+
+std::size_t ReadaheadVfsFile::GetSize() const {
+    return file->GetSize();
+}
+
+bool ReadaheadVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir ReadaheadVfsFile::GetContainingDirectory() const {
+    return file->GetContainingDirectory();
+}
+
+bool ReadaheadVfsFile::IsWritable() const {
+    return false;
+}
+
+bool ReadaheadVfsFile::IsReadable() const {
+    return file->IsReadable();
+}
+
+std::size_t ReadaheadVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    bool sequential;
+    {
+        std::scoped_lock lock{pattern_mutex};
+        sequential = offset == next_offset && offset != 0;
+        next_offset = offset + length;
+    }
+    if (!sequential) {
+        // Random accesses go straight to the file, prefetching only pays off for streams
+        return file->Read(data, length, offset);
+    }
+    const std::size_t read_size = ReadThroughCache(data, length, offset);
+
+    const std::size_t next_block = (offset + length) / ReadaheadScheduler::BLOCK_SIZE;
+    for (std::size_t i = 0; i < ReadaheadScheduler::WINDOW_BLOCKS; ++i) {
+        scheduler->Prefetch(stream_id, file, next_block + i);
+    }
+    return read_size;
+}
+
+std::size_t ReadaheadVfsFile::ReadThroughCache(u8* data, std::size_t length,
+                                               std::size_t offset) const {
+    constexpr std::size_t BLOCK_SIZE = ReadaheadScheduler::BLOCK_SIZE;
+
+    // Parts that are not cached are merged into a single read from the file
+    std::size_t pending_begin = 0;
+    std::size_t pending_size = 0;
+    const auto flush_pending = [&] {
+        const std::size_t expected = pending_size;
+        pending_size = 0;
+        if (expected == 0) {
+            return true;
+        }
+        const std::size_t read = file->Read(data + pending_begin, expected, offset + pending_begin);
+        if (read != expected) {
+            // Short reads only happen at the end of the file
+            pending_begin += read;
+            return false;
+        }
+        return true;
+    };
+
+    std::size_t done = 0;
+    while (done < length) {
+        const std::size_t position = offset + done;
+        const std::size_t block_offset = position % BLOCK_SIZE;
+        const std::size_t chunk = std::min(length - done, BLOCK_SIZE - block_offset);
+
+        const auto block = scheduler->Find(stream_id, position / BLOCK_SIZE);
+        const std::vector<u8>* const block_data = block ? &block->Wait() : nullptr;
+        if (block_data == nullptr || block_offset + chunk > block_data->size()) {
+            if (pending_size == 0) {
+                pending_begin = done;
+            }
+            pending_size += chunk;
+            done += chunk;
+            continue;
+        }
+        if (!flush_pending()) {
+            return pending_begin;
+        }
+        std::memcpy(data + done, block_data->data() + block_offset, chunk);
+        done += chunk;
+    }
+    if (!flush_pending()) {
+        return pending_begin;
+    }
+    return done;
+}
+
+std::size_t ReadaheadVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool ReadaheadVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+} // namespace FileSys
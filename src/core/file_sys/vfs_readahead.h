@@ -0,0 +1,120 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/hash.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+/**
+ * Reads ahead of sequential accesses to read-only files on a pool of I/O threads.
+ *
+ * Blocks are read through the whole layer stack of the wrapped file, so they are cached already
+ * decrypted and patched. The cache is shared by every file wrapped by the scheduler and bounded,
+ * blocks that were used the longest time ago are dropped first.
+ */
+class ReadaheadScheduler final : public std::enable_shared_from_this<ReadaheadScheduler> {
+public:
+    /// Size of a prefetched block, reads are split along block boundaries
+    static constexpr std::size_t BLOCK_SIZE = 0x40000;
+
+    /// Number of blocks read ahead of a sequential access
+    static constexpr std::size_t WINDOW_BLOCKS = 8;
+
+    explicit ReadaheadScheduler(std::size_t num_threads, std::size_t capacity_bytes);
+    ~ReadaheadScheduler();
+
+    /// Wraps a file so sequential reads from it are prefetched. Writable files are returned as is.
+    [[nodiscard]] VirtualFile Wrap(VirtualFile file);
+
+    /// Returns the number of blocks that are cached or being read, across every wrapped file
+    [[nodiscard]] std::size_t NumCachedBlocks();
+
+private:
+    friend class ReadaheadVfsFile;
+
+    /// Block of a file, filled by an I/O thread
+    struct Block {
+        /// Waits for the block to be read and returns its data
+        const std::vector<u8>& Wait();
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool ready = false;
+        std::vector<u8> data;
+    };
+
+    using BlockKey = std::pair<u64, std::size_t>;
+
+    struct CacheEntry {
+        std::shared_ptr<Block> block;
+        std::list<BlockKey>::iterator lru_iterator;
+    };
+
+    /// Returns a cached or in-flight block, or nullptr when it has not been requested
+    std::shared_ptr<Block> Find(u64 stream_id, std::size_t index);
+
+    /// Requests a block of file to be read in the background unless it is already cached
+    void Prefetch(u64 stream_id, const VirtualFile& file, std::size_t index);
+
+    /// Drops every cached block of a stream
+    void Forget(u64 stream_id);
+
+    /// Evicts the least recently used blocks until the cache fits in its capacity
+    void EvictOverCapacity();
+
+    const std::size_t capacity;
+
+    std::atomic<u64> next_stream_id{1};
+
+    std::mutex mutex;
+    std::unordered_map<BlockKey, CacheEntry, Common::PairHash> cache;
+    std::list<BlockKey> lru;
+
+    Common::ThreadWorker workers;
+};
+
+/// Read-only file that serves sequential reads from blocks prefetched by a ReadaheadScheduler
+class ReadaheadVfsFile final : public VfsFile {
+public:
+    explicit ReadaheadVfsFile(VirtualFile file_, std::shared_ptr<ReadaheadScheduler> scheduler_,
+                              u64 stream_id_);
+    ~ReadaheadVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+private:
+    /// Copies the cached parts of a read and reads the others from the file
+    std::size_t ReadThroughCache(u8* data, std::size_t length, std::size_t offset) const;
+
+    VirtualFile file;
+    std::shared_ptr<ReadaheadScheduler> scheduler;
+    u64 stream_id;
+
+    mutable std::mutex pattern_mutex;
+    mutable std::size_t next_offset = 0;
+};
+
+} // namespace FileSys
@@ -3,8 +3,11 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <mutex>
 #include <utility>
 #include "common/assert.h"
 #include "common/common_paths.h"
@@ -16,6 +19,15 @@ namespace FileSys {
 
 namespace FS = Common::FS;
 
+// Files opened on the same path share their IOFile, and its accesses are a seek followed by the
+// transfer. Serialize them so files can be read and written from several threads.
+static std::mutex& BackingLock(const FS::IOFile* backing) {
+    static std::array<std::mutex, 64> locks;
+    // Heap allocations are at least 16 byte aligned, the low bits of the address are always zero
+    const auto address = reinterpret_cast<std::uintptr_t>(backing);
+    return locks[(address >> 4) % locks.size()];
+}
+
 static std::string ModeFlagsToString(Mode mode) {
     std::string mode_str;
 
@@ -262,10 +274,12 @@ std::string RealVfsFile::GetName() const {
 }
 
 std::size_t RealVfsFile::GetSize() const {
+    std::scoped_lock lock{BackingLock(backing.get())};
     return backing->GetSize();
 }
 
 bool RealVfsFile::Resize(std::size_t new_size) {
+    std::scoped_lock lock{BackingLock(backing.get())};
     return backing->Resize(new_size);
 }
 
@@ -282,6 +296,7 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    std::scoped_lock lock{BackingLock(backing.get())};
     if (!backing->Seek(static_cast<s64>(offset), SEEK_SET)) {
         return 0;
     }
@@ -289,6 +304,7 @@ std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset)
 }
 
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    std::scoped_lock lock{BackingLock(backing.get())};
     if (!backing->Seek(static_cast<s64>(offset), SEEK_SET)) {
         return 0;
     }
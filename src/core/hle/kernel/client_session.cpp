@@ -8,6 +8,7 @@
 #include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/server_session.h"
 #include "core/hle/kernel/session.h"
+#include "core/hle/kernel/slab_helpers.h"
 #include "core/hle/result.h"
 
 namespace Kernel {
@@ -30,7 +31,8 @@ bool ClientSession::IsSignaled() const {
 ResultVal<std::shared_ptr<ClientSession>> ClientSession::Create(KernelCore& kernel,
                                                                 std::shared_ptr<Session> parent,
                                                                 std::string name) {
-    std::shared_ptr<ClientSession> client_session{std::make_shared<ClientSession>(kernel)};
+    std::shared_ptr<ClientSession> client_session{
+        AdoptSlabObject(new (AllocateSlabStorage<ClientSession>()) ClientSession(kernel))};
 
     client_session->name = std::move(name);
     client_session->parent = std::move(parent);
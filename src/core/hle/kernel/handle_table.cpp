@@ -120,6 +120,19 @@ std::shared_ptr<Object> HandleTable::GetGeneric(Handle handle) const {
     return objects[GetSlot(handle)];
 }
 
+Object* HandleTable::GetGenericPointer(Handle handle) const {
+    if (handle == CurrentThread) {
+        return kernel.CurrentScheduler()->GetCurrentThread();
+    } else if (handle == CurrentProcess) {
+        return kernel.CurrentProcess();
+    }
+
+    if (!IsValid(handle)) {
+        return nullptr;
+    }
+    return objects[GetSlot(handle)].get();
+}
+
 void HandleTable::Clear() {
     for (u16 i = 0; i < table_size; ++i) {
         generations[i] = static_cast<u16>(i + 1);
@@ -108,10 +108,25 @@ public:
         return DynamicObjectCast<T>(GetGeneric(handle));
     }
 
+    /**
+     * Looks up a handle while verifying its type, without taking a reference to the object.
+     * The pointer is only valid while the handle remains open, which makes it suitable for SVCs
+     * that use the object for the duration of the call.
+     * @return Pointer to the looked-up object, or `nullptr` if the handle is not valid or its
+     *         type differs from the requested one.
+     */
+    template <class T>
+    T* GetPointer(Handle handle) const {
+        return DynamicObjectCast<T>(GetGenericPointer(handle));
+    }
+
     /// Closes all handles held in this table.
     void Clear();
 
 private:
+    /// Looks up a handle without taking a reference to the object.
+    Object* GetGenericPointer(Handle handle) const;
+
     /// Stores the Object referenced by the handle or null if the slot is empty.
     std::array<std::shared_ptr<Object>, MAX_COUNT> objects;
 
@@ -272,6 +272,26 @@ std::vector<u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
     return buffer;
 }
 
+std::size_t HLERequestContext::ReadBuffer(std::span<u8> buffer, std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+
+    if (is_buffer_a) {
+        const auto& descriptor{BufferDescriptorA()[buffer_index]};
+        const std::size_t size{std::min<std::size_t>(descriptor.Size(), buffer.size())};
+        memory.ReadBlock(descriptor.Address(), buffer.data(), size);
+        return size;
+    }
+
+    ASSERT_OR_EXECUTE_MSG(
+        BufferDescriptorX().size() > buffer_index, { return 0; },
+        "BufferDescriptorX invalid buffer_index {}", buffer_index);
+    const auto& descriptor{BufferDescriptorX()[buffer_index]};
+    const std::size_t size{std::min<std::size_t>(descriptor.Size(), buffer.size())};
+    memory.ReadBlock(descriptor.Address(), buffer.data(), size);
+    return size;
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
@@ -338,6 +358,20 @@ std::size_t HLERequestContext::GetWriteBufferSize(std::size_t buffer_index) cons
     return 0;
 }
 
+std::span<u8> HLERequestContext::GetWriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        const auto& descriptor{BufferDescriptorB()[buffer_index]};
+        return memory.GetContiguousSpan(descriptor.Address(), descriptor.Size());
+    }
+    if (BufferDescriptorC().size() <= buffer_index) {
+        return {};
+    }
+    const auto& descriptor{BufferDescriptorC()[buffer_index]};
+    return memory.GetContiguousSpan(descriptor.Address(), descriptor.Size());
+}
+
 std::string HLERequestContext::Description() const {
     if (!command_header) {
         return "No command header available";
@@ -55,4 +55,12 @@ inline std::shared_ptr<KSynchronizationObject> DynamicObjectCast<KSynchronizatio
     return nullptr;
 }
 
+template <>
+inline KSynchronizationObject* DynamicObjectCast<KSynchronizationObject>(Object* object) {
+    if (object != nullptr && object->IsWaitable()) {
+        return static_cast<KSynchronizationObject*>(object);
+    }
+    return nullptr;
+}
+
 } // namespace Kernel
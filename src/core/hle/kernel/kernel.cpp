@@ -18,6 +18,7 @@
 #include "common/thread_worker.h"
 #include "core/arm/arm_interface.h"
 #include "core/arm/cpu_interrupt_handler.h"
+#include "core/arm/dynarmic/arm_dynarmic_jit_cache.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -489,12 +490,22 @@ const Core::ExclusiveMonitor& KernelCore::GetExclusiveMonitor() const {
 }
 
 void KernelCore::InvalidateAllInstructionCaches() {
+    Process* const process = impl->current_process;
+    if (process != nullptr && process->Is64BitProcess()) {
+        process->JitCache().ClearCache();
+        return;
+    }
     for (auto& physical_core : impl->cores) {
         physical_core.ArmInterface().ClearInstructionCache();
     }
 }
 
 void KernelCore::InvalidateCpuInstructionCacheRange(VAddr addr, std::size_t size) {
+    Process* const process = impl->current_process;
+    if (process != nullptr && process->Is64BitProcess()) {
+        process->JitCache().InvalidateCacheRange(addr, size);
+        return;
+    }
     for (auto& physical_core : impl->cores) {
         if (!physical_core.IsInitialized()) {
             continue;
@@ -10,6 +10,7 @@
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/arm/dynarmic/arm_dynarmic_jit_cache.h"
 #include "core/core.h"
 #include "core/device_memory.h"
 #include "core/file_sys/program_metadata.h"
@@ -442,7 +443,8 @@ bool Process::IsSignaled() const {
 
 Process::Process(Core::System& system)
     : KSynchronizationObject{system.Kernel()},
-      page_table{std::make_unique<Memory::PageTable>(system)}, handle_table{system.Kernel()},
+      page_table{std::make_unique<Memory::PageTable>(system)},
+      jit_cache{std::make_unique<Core::DynarmicJitCache64>()}, handle_table{system.Kernel()},
       address_arbiter{system}, condition_var{system}, state_lock{system.Kernel()}, system{system} {}
 
 Process::~Process() = default;
@@ -19,6 +19,7 @@
 #include "core/hle/result.h"
 
 namespace Core {
+class DynarmicJitCache64;
 class System;
 }
 
@@ -217,6 +218,11 @@ public:
         return is_64bit_process;
     }
 
+    /// Gets the AArch64 JIT instances shared by the cores executing this process.
+    Core::DynarmicJitCache64& JitCache() {
+        return *jit_cache;
+    }
+
     [[nodiscard]] bool IsSuspended() const {
         return is_suspended;
     }
@@ -387,6 +393,9 @@ private:
     /// Memory manager for this process
     std::unique_ptr<Memory::PageTable> page_table;
 
+    /// JIT instances executing this process, released together with its page table
+    std::unique_ptr<Core::DynarmicJitCache64> jit_cache;
+
     /// Current status of the process
     ProcessStatus status{};
 
@@ -20,6 +20,7 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_session.h"
 #include "core/hle/kernel/session.h"
+#include "core/hle/kernel/slab_helpers.h"
 #include "core/memory.h"
 
 namespace Kernel {
@@ -33,7 +34,8 @@ ServerSession::~ServerSession() {
 ResultVal<std::shared_ptr<ServerSession>> ServerSession::Create(KernelCore& kernel,
                                                                 std::shared_ptr<Session> parent,
                                                                 std::string name) {
-    std::shared_ptr<ServerSession> session{std::make_shared<ServerSession>(kernel)};
+    std::shared_ptr<ServerSession> session{
+        AdoptSlabObject(new (AllocateSlabStorage<ServerSession>()) ServerSession(kernel))};
 
     session->name = std::move(name);
     session->parent = std::move(parent);
@@ -0,0 +1,146 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/common_funcs.h"
+#include "common/spin_lock.h"
+
+namespace Kernel {
+
+namespace impl {
+
+/**
+ * Pool of fixed size blocks shared by every object of the same size and alignment. Blocks are
+ * carved out of chunks that are allocated on demand and never returned to the global allocator,
+ * so once a title reaches its steady state object creation does not touch the heap.
+ */
+template <std::size_t BlockSize, std::size_t BlockAlign>
+class SlabPool final : NonCopyable {
+public:
+    static SlabPool& Instance() {
+        // Intentionally leaked: objects released while static instances such as System are
+        // destroyed still return their blocks here, after function-local statics are gone.
+        static SlabPool& pool = *new SlabPool;
+        return pool;
+    }
+
+    void* Allocate() {
+        std::scoped_lock lock{guard};
+        if (head == nullptr) {
+            Grow();
+        }
+        Node* const node = head;
+        head = node->next;
+        return node;
+    }
+
+    void Free(void* block) {
+        std::scoped_lock lock{guard};
+        Node* const node = static_cast<Node*>(block);
+        node->next = head;
+        head = node;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    static constexpr std::size_t Alignment = std::max(BlockAlign, alignof(Node));
+    static constexpr std::size_t Stride = Common::AlignUp(std::max(BlockSize, sizeof(Node)),
+                                                          Alignment);
+    static constexpr std::size_t BlocksPerChunk = 64;
+
+    struct ChunkDeleter {
+        void operator()(std::byte* chunk) const {
+            ::operator delete[](chunk, std::align_val_t{Alignment});
+        }
+    };
+
+    SlabPool() = default;
+
+    void Grow() {
+        auto* const chunk = static_cast<std::byte*>(
+            ::operator new[](Stride * BlocksPerChunk, std::align_val_t{Alignment}));
+        chunks.emplace_back(chunk);
+        for (std::size_t i = BlocksPerChunk; i-- > 0;) {
+            Node* const node = reinterpret_cast<Node*>(chunk + i * Stride);
+            node->next = head;
+            head = node;
+        }
+    }
+
+    Common::SpinLock guard;
+    Node* head{};
+    std::vector<std::unique_ptr<std::byte[], ChunkDeleter>> chunks;
+};
+
+} // namespace impl
+
+/// Standard allocator that serves single object allocations from a per-type slab pool.
+template <typename T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    SlabAllocator() = default;
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        if (count != 1) {
+            return std::allocator<T>{}.allocate(count);
+        }
+        return static_cast<T*>(Pool().Allocate());
+    }
+
+    void deallocate(T* pointer, std::size_t count) {
+        if (count != 1) {
+            std::allocator<T>{}.deallocate(pointer, count);
+            return;
+        }
+        Pool().Free(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>&) const {
+        return true;
+    }
+
+private:
+    static impl::SlabPool<sizeof(T), alignof(T)>& Pool() {
+        return impl::SlabPool<sizeof(T), alignof(T)>::Instance();
+    }
+};
+
+/// Returns uninitialized storage for a T taken from its slab pool.
+template <typename T>
+void* AllocateSlabStorage() {
+    return SlabAllocator<T>{}.allocate(1);
+}
+
+/**
+ * Takes ownership of an object constructed in storage returned by AllocateSlabStorage. Both the
+ * object and the shared_ptr control block are recycled through slab pools when released.
+ */
+template <typename T>
+std::shared_ptr<T> AdoptSlabObject(T* object) {
+    const auto deleter = [](T* pointer) {
+        pointer->~T();
+        SlabAllocator<T>{}.deallocate(pointer, 1);
+    };
+    return std::shared_ptr<T>(object, deleter, SlabAllocator<T>{});
+}
+
+} // namespace Kernel
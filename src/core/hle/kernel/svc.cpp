@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cinttypes>
 #include <iterator>
 #include <mutex>
@@ -445,22 +446,22 @@ static ResultCode WaitSynchronization(Core::System& system, s32* index, VAddr ha
     }
 
     auto& kernel = system.Kernel();
-    std::vector<KSynchronizationObject*> objects(handle_count);
+    std::array<KSynchronizationObject*, MaxHandles> objects{};
     const auto& handle_table = kernel.CurrentProcess()->GetHandleTable();
 
     for (u64 i = 0; i < handle_count; ++i) {
         const Handle handle = memory.Read32(handles_address + i * sizeof(Handle));
-        const auto object = handle_table.Get<KSynchronizationObject>(handle);
+        auto* const object = handle_table.GetPointer<KSynchronizationObject>(handle);
 
         if (object == nullptr) {
             LOG_ERROR(Kernel_SVC, "Object is a nullptr");
             return ERR_INVALID_HANDLE;
         }
 
-        objects[i] = object.get();
+        objects[i] = object;
     }
     return KSynchronizationObject::Wait(kernel, index, objects.data(),
-                                        static_cast<s32>(objects.size()), nano_seconds);
+                                        static_cast<s32>(handle_count), nano_seconds);
 }
 
 static ResultCode WaitSynchronization32(Core::System& system, u32 timeout_low, u32 handles_address,
@@ -475,7 +476,7 @@ static ResultCode CancelSynchronization(Core::System& system, Handle thread_hand
 
     // Get the thread from its handle.
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    std::shared_ptr<KThread> thread = handle_table.Get<KThread>(thread_handle);
+    auto* const thread = handle_table.GetPointer<KThread>(thread_handle);
     R_UNLESS(thread, Svc::ResultInvalidHandle);
 
     // Cancel the thread's wait.
@@ -1726,12 +1727,12 @@ static ResultCode ResetSignal(Core::System& system, Handle handle) {
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
 
-    auto event = handle_table.Get<ReadableEvent>(handle);
+    auto* const event = handle_table.GetPointer<ReadableEvent>(handle);
     if (event) {
         return event->Reset();
     }
 
-    auto process = handle_table.Get<Process>(handle);
+    auto* const process = handle_table.GetPointer<Process>(handle);
     if (process) {
         return process->ClearSignalState();
     }
@@ -1902,13 +1903,13 @@ static ResultCode ClearEvent(Core::System& system, Handle handle) {
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
 
-    auto writable_event = handle_table.Get<WritableEvent>(handle);
+    auto* const writable_event = handle_table.GetPointer<WritableEvent>(handle);
     if (writable_event) {
         writable_event->Clear();
         return RESULT_SUCCESS;
     }
 
-    auto readable_event = handle_table.Get<ReadableEvent>(handle);
+    auto* const readable_event = handle_table.GetPointer<ReadableEvent>(handle);
     if (readable_event) {
         readable_event->Clear();
         return RESULT_SUCCESS;
@@ -1926,7 +1927,7 @@ static ResultCode SignalEvent(Core::System& system, Handle handle) {
     LOG_DEBUG(Kernel_SVC, "called. Handle=0x{:08X}", handle);
 
     HandleTable& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    auto writable_event = handle_table.Get<WritableEvent>(handle);
+    auto* const writable_event = handle_table.GetPointer<WritableEvent>(handle);
 
     if (!writable_event) {
         LOG_ERROR(Kernel_SVC, "Non-existent writable event handle used (0x{:08X})", handle);
@@ -8,6 +8,7 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/kernel/readable_event.h"
+#include "core/hle/kernel/slab_helpers.h"
 #include "core/hle/kernel/writable_event.h"
 
 namespace Kernel {
@@ -16,8 +17,10 @@ WritableEvent::WritableEvent(KernelCore& kernel) : Object{kernel} {}
 WritableEvent::~WritableEvent() = default;
 
 EventPair WritableEvent::CreateEventPair(KernelCore& kernel, std::string name) {
-    std::shared_ptr<WritableEvent> writable_event(new WritableEvent(kernel));
-    std::shared_ptr<ReadableEvent> readable_event(new ReadableEvent(kernel));
+    std::shared_ptr<WritableEvent> writable_event =
+        AdoptSlabObject(new (AllocateSlabStorage<WritableEvent>()) WritableEvent(kernel));
+    std::shared_ptr<ReadableEvent> readable_event =
+        AdoptSlabObject(new (AllocateSlabStorage<ReadableEvent>()) ReadableEvent(kernel));
 
     writable_event->name = name + ":Writable";
     writable_event->readable = readable_event;
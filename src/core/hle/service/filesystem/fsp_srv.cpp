@@ -2,9 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
+#include <mutex>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +27,7 @@
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/system_archive/system_archive.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_readahead.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -55,6 +59,79 @@ enum class FileSystemType : u8 {
     ApplicationPackage = 7,
 };
 
+namespace {
+/// Number of I/O threads reading ahead of sequential RomFS accesses
+constexpr std::size_t READAHEAD_THREADS = 2;
+
+/// Memory used by blocks read ahead of the game, shared by every opened storage
+constexpr std::size_t READAHEAD_CACHE_SIZE = 32 * 1024 * 1024;
+
+/// Accumulates the throughput of storage and file reads and logs it periodically
+class ReadStatistics {
+public:
+    void Record(std::size_t bytes, bool direct, std::chrono::nanoseconds elapsed) {
+        std::scoped_lock lock{mutex};
+        total_bytes += bytes;
+        if (direct) {
+            direct_bytes += bytes;
+        }
+        busy_time += elapsed;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_report < REPORT_INTERVAL) {
+            return;
+        }
+        const double seconds = std::chrono::duration<double>(busy_time).count();
+        const double mib = static_cast<double>(total_bytes) / (1024.0 * 1024.0);
+        LOG_DEBUG(Service_FS, "Read {:.1f} MiB at {:.1f} MiB/s, {:.0f}% directly to guest memory",
+                  mib, seconds > 0.0 ? mib / seconds : 0.0,
+                  total_bytes != 0 ? 100.0 * static_cast<double>(direct_bytes) /
+                                         static_cast<double>(total_bytes)
+                                   : 0.0);
+        last_report = now;
+        total_bytes = 0;
+        direct_bytes = 0;
+        busy_time = {};
+    }
+
+private:
+    static constexpr std::chrono::seconds REPORT_INTERVAL{5};
+
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point last_report = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds busy_time{};
+    std::size_t total_bytes = 0;
+    std::size_t direct_bytes = 0;
+};
+
+ReadStatistics read_statistics;
+
+/**
+ * Reads length bytes at offset from backend into the output buffer of ctx. When the output buffer
+ * is contiguous in host memory the data is read straight into it, otherwise it goes through an
+ * intermediate buffer.
+ *
+ * @returns The number of bytes read.
+ */
+std::size_t ReadToBuffer(Kernel::HLERequestContext& ctx, const FileSys::VirtualFile& backend,
+                         std::size_t length, std::size_t offset) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::span<u8> guest_buffer = length != 0 ? ctx.GetWriteBufferSpan() : std::span<u8>{};
+    const bool direct = guest_buffer.size() >= length && !guest_buffer.empty();
+
+    std::size_t read_size;
+    if (direct) {
+        read_size = backend->Read(guest_buffer.data(), length, offset);
+    } else {
+        const std::vector<u8> output = backend->ReadBytes(length, offset);
+        ctx.WriteBuffer(output);
+        read_size = output.size();
+    }
+    read_statistics.Record(read_size, direct, std::chrono::steady_clock::now() - start);
+    return read_size;
+}
+} // Anonymous namespace
+
 class IStorage final : public ServiceFramework<IStorage> {
 public:
     explicit IStorage(Core::System& system_, FileSys::VirtualFile backend_)
@@ -94,10 +171,9 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into guest memory
+        ReadToBuffer(ctx, backend, static_cast<std::size_t>(length),
+                     static_cast<std::size_t>(offset));
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(RESULT_SUCCESS);
@@ -151,15 +227,13 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into guest memory
+        const std::size_t read_size = ReadToBuffer(ctx, backend, static_cast<std::size_t>(length),
+                                                   static_cast<std::size_t>(offset));
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(RESULT_SUCCESS);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read_size));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -654,7 +728,10 @@ private:
 
 FSP_SRV::FSP_SRV(Core::System& system_)
     : ServiceFramework{system_, "fsp-srv"}, fsc{system.GetFileSystemController()},
-      content_provider{system.GetContentProvider()}, reporter{system.GetReporter()} {
+      content_provider{system.GetContentProvider()},
+      readahead{std::make_shared<FileSys::ReadaheadScheduler>(READAHEAD_THREADS,
+                                                              READAHEAD_CACHE_SIZE)},
+      reporter{system.GetReporter()} {
     // clang-format off
     static const FunctionInfo functions[] = {
         {0, nullptr, "OpenFileSystem"},
@@ -935,7 +1012,8 @@ void FSP_SRV::OpenDataStorageByCurrentProcess(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    auto storage = std::make_shared<IStorage>(system, std::move(romfs.Unwrap()));
+    auto storage = std::make_shared<IStorage>(system,
+                                              readahead->Wrap(std::move(romfs.Unwrap())));
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
@@ -959,7 +1037,7 @@ void FSP_SRV::OpenDataStorageByDataId(Kernel::HLERequestContext& ctx) {
         if (archive != nullptr) {
             IPC::ResponseBuilder rb{ctx, 2, 0, 1};
             rb.Push(RESULT_SUCCESS);
-            rb.PushIpcInterface(std::make_shared<IStorage>(system, archive));
+            rb.PushIpcInterface(std::make_shared<IStorage>(system, readahead->Wrap(archive)));
             return;
         }
 
@@ -975,7 +1053,8 @@ void FSP_SRV::OpenDataStorageByDataId(Kernel::HLERequestContext& ctx) {
     const FileSys::PatchManager pm{title_id, fsc, content_provider};
 
     auto storage = std::make_shared<IStorage>(
-        system, pm.PatchRomFS(std::move(data.Unwrap()), 0, FileSys::ContentRecordType::Data));
+        system, readahead->Wrap(pm.PatchRomFS(std::move(data.Unwrap()), 0,
+                                              FileSys::ContentRecordType::Data)));
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
@@ -1013,7 +1092,8 @@ void FSP_SRV::OpenDataStorageWithProgramIndex(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    auto storage = std::make_shared<IStorage>(system, std::move(romfs.Unwrap()));
+    auto storage = std::make_shared<IStorage>(system,
+                                              readahead->Wrap(std::move(romfs.Unwrap())));
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
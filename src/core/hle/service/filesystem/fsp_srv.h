@@ -14,6 +14,7 @@ class Reporter;
 namespace FileSys {
 class ContentProvider;
 class FileSystemBackend;
+class ReadaheadScheduler;
 } // namespace FileSys
 
 namespace Service::FileSystem {
@@ -58,6 +59,7 @@ private:
 
     FileSystemController& fsc;
     const FileSys::ContentProvider& content_provider;
+    std::shared_ptr<FileSys::ReadaheadScheduler> readahead;
 
     FileSys::VirtualFile romfs;
     u64 current_process_id = 0;
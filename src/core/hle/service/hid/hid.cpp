@@ -41,6 +41,7 @@ namespace Service::HID {
 // HID is polled every 15ms, this value was derived from
 // https://github.com/dekuNukem/Nintendo_Switch_Reverse_Engineering#joy-con-status-data-packet
 constexpr auto pad_update_ns = std::chrono::nanoseconds{1000 * 1000};         // (1ms, 1000Hz)
+constexpr auto default_update_ns = std::chrono::nanoseconds{4 * 1000 * 1000}; // (4ms, 250Hz)
 constexpr auto motion_update_ns = std::chrono::nanoseconds{15 * 1000 * 1000}; // (15ms, 66.666Hz)
 constexpr std::size_t SHARED_MEMORY_SIZE = 0x40000;
 
@@ -77,6 +78,12 @@ IAppletResource::IAppletResource(Core::System& system_)
     // Register update callbacks
     pad_update_event = Core::Timing::CreateEvent(
         "HID::UpdatePadCallback",
+        [this](std::uintptr_t user_data, std::chrono::nanoseconds ns_late) {
+            const auto guard = LockService();
+            UpdateNpad(user_data, ns_late);
+        });
+    default_update_event = Core::Timing::CreateEvent(
+        "HID::UpdateDefaultCallback",
         [this](std::uintptr_t user_data, std::chrono::nanoseconds ns_late) {
             const auto guard = LockService();
             UpdateControllers(user_data, ns_late);
@@ -89,6 +96,7 @@ IAppletResource::IAppletResource(Core::System& system_)
         });
 
     system.CoreTiming().ScheduleEvent(pad_update_ns, pad_update_event);
+    system.CoreTiming().ScheduleEvent(default_update_ns, default_update_event);
     system.CoreTiming().ScheduleEvent(motion_update_ns, motion_update_event);
 
     ReloadInputDevices();
@@ -104,6 +112,8 @@ void IAppletResource::DeactivateController(HidController controller) {
 
 IAppletResource ::~IAppletResource() {
     system.CoreTiming().UnscheduleEvent(pad_update_event, 0);
+    system.CoreTiming().UnscheduleEvent(default_update_event, 0);
+    system.CoreTiming().UnscheduleEvent(motion_update_event, 0);
 }
 
 void IAppletResource::GetSharedMemoryHandle(Kernel::HLERequestContext& ctx) {
@@ -118,14 +128,29 @@ void IAppletResource::UpdateControllers(std::uintptr_t user_data,
                                         std::chrono::nanoseconds ns_late) {
     auto& core_timing = system.CoreTiming();
 
+    // Only the npad needs the 1000Hz cadence, the remaining controllers either change at human
+    // input rates or are stubbed, so they share a slower update.
     const bool should_reload = Settings::values.is_device_reload_pending.exchange(false);
-    for (const auto& controller : controllers) {
+    for (std::size_t i = 0; i < controllers.size(); ++i) {
+        auto& controller = controllers[i];
         if (should_reload) {
             controller->OnLoadInputDevices();
         }
+        if (static_cast<HidController>(i) == HidController::NPad) {
+            continue;
+        }
         controller->OnUpdate(core_timing, shared_mem->GetPointer(), SHARED_MEMORY_SIZE);
     }
 
+    core_timing.ScheduleEvent(default_update_ns - ns_late, default_update_event);
+}
+
+void IAppletResource::UpdateNpad(std::uintptr_t user_data, std::chrono::nanoseconds ns_late) {
+    auto& core_timing = system.CoreTiming();
+
+    controllers[static_cast<size_t>(HidController::NPad)]->OnUpdate(
+        core_timing, shared_mem->GetPointer(), SHARED_MEMORY_SIZE);
+
     core_timing.ScheduleEvent(pad_update_ns - ns_late, pad_update_event);
 }
 
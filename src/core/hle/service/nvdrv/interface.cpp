@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
+#include <span>
+#include <vector>
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/hle/ipc_helpers.h"
@@ -16,6 +19,34 @@
 
 namespace Service::Nvidia {
 
+namespace {
+/// Scratch storage reused by every ioctl issued from the same service thread. Submits and event
+/// waits are issued many times per frame, so the buffers are only grown and never released.
+struct IoctlBuffers {
+    std::vector<u8> input;
+    std::vector<u8> inline_input;
+    std::vector<u8> output;
+    std::vector<u8> inline_output;
+};
+
+thread_local IoctlBuffers ioctl_buffers;
+
+/// Reads the input buffer at the given index into the scratch storage and returns a view of it.
+std::span<const u8> ReadIoctlInput(Kernel::HLERequestContext& ctx, std::vector<u8>& storage,
+                                   std::size_t buffer_index) {
+    storage.resize(ctx.GetReadBufferSize(buffer_index));
+    return std::span<const u8>(storage.data(), ctx.ReadBuffer(storage, buffer_index));
+}
+
+/// Prepares zeroed scratch storage for the output buffer at the given index.
+std::span<u8> PrepareIoctlOutput(Kernel::HLERequestContext& ctx, std::vector<u8>& storage,
+                                 std::size_t buffer_index) {
+    storage.resize(ctx.GetWriteBufferSize(buffer_index));
+    std::fill(storage.begin(), storage.end(), u8{0});
+    return storage;
+}
+} // Anonymous namespace
+
 void NVDRV::SignalGPUInterruptSyncpt(const u32 syncpoint_id, const u32 value) {
     nvdrv->SignalSyncpt(syncpoint_id, value);
 }
@@ -58,12 +89,12 @@ void NVDRV::Ioctl1(Kernel::HLERequestContext& ctx) {
     }
 
     // Check device
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    const auto input_buffer = ctx.ReadBuffer(0);
+    const auto input_buffer = ReadIoctlInput(ctx, ioctl_buffers.input, 0);
+    const auto output_buffer = PrepareIoctlOutput(ctx, ioctl_buffers.output, 0);
 
     const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.WriteBuffer(output_buffer.data(), output_buffer.size());
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -83,14 +114,14 @@ void NVDRV::Ioctl2(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
+    const auto input_buffer = ReadIoctlInput(ctx, ioctl_buffers.input, 0);
+    const auto input_inlined_buffer = ReadIoctlInput(ctx, ioctl_buffers.inline_input, 1);
+    const auto output_buffer = PrepareIoctlOutput(ctx, ioctl_buffers.output, 0);
 
     const auto nv_result =
         nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.WriteBuffer(output_buffer.data(), output_buffer.size());
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -110,15 +141,15 @@ void NVDRV::Ioctl3(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    std::vector<u8> output_buffer_inline(ctx.GetWriteBufferSize(1));
+    const auto input_buffer = ReadIoctlInput(ctx, ioctl_buffers.input, 0);
+    const auto output_buffer = PrepareIoctlOutput(ctx, ioctl_buffers.output, 0);
+    const auto output_buffer_inline = PrepareIoctlOutput(ctx, ioctl_buffers.inline_output, 1);
 
     const auto nv_result =
         nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, output_buffer_inline);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(output_buffer_inline, 1);
+        ctx.WriteBuffer(output_buffer.data(), output_buffer.size(), 0);
+        ctx.WriteBuffer(output_buffer_inline.data(), output_buffer_inline.size(), 1);
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
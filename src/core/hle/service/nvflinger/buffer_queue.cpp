@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <bit>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -25,12 +26,6 @@ void BufferQueue::SetPreallocatedBuffer(u32 slot, const IGBPBuffer& igbp_buffer)
     ASSERT(slot < buffer_slots);
     LOG_WARNING(Service, "Adding graphics buffer {}", slot);
 
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers.push_back(slot);
-    }
-    free_buffers_condition.notify_one();
-
     buffers[slot] = {
         .slot = slot,
         .status = Buffer::Status::Free,
@@ -39,17 +34,22 @@ void BufferQueue::SetPreallocatedBuffer(u32 slot, const IGBPBuffer& igbp_buffer)
         .crop_rect = {},
         .swap_interval = 0,
         .multi_fence = {},
+        .frame_number = 0,
+        .queue_time = {},
     };
+    FreeSlot(slot);
 
     buffer_wait_event.writable->Signal();
 }
 
 std::optional<std::pair<u32, Service::Nvidia::MultiFence*>> BufferQueue::DequeueBuffer(u32 width,
                                                                                        u32 height) {
-    // Wait for first request before trying to dequeue
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers_condition.wait(lock, [this] { return !free_buffers.empty() || !is_connect; });
+    // Wait for first request before trying to dequeue. The generation is sampled before checking
+    // the mask so a slot freed in between makes the wait return immediately.
+    u32 generation = free_slots_generation.load(std::memory_order_acquire);
+    while (free_slots.load(std::memory_order_acquire) == 0 && is_connect) {
+        free_slots_generation.wait(generation, std::memory_order_acquire);
+        generation = free_slots_generation.load(std::memory_order_acquire);
     }
 
     if (!is_connect) {
@@ -58,26 +58,25 @@ std::optional<std::pair<u32, Service::Nvidia::MultiFence*>> BufferQueue::Dequeue
         return std::nullopt;
     }
 
-    std::unique_lock lock{free_buffers_mutex};
-
-    auto f_itr = free_buffers.begin();
-    auto slot = buffers.size();
+    u64 candidates = free_slots.load(std::memory_order_acquire);
+    while (candidates != 0) {
+        const auto slot = static_cast<u32>(std::countr_zero(candidates));
+        const u64 slot_bit = u64{1} << slot;
+        candidates &= ~slot_bit;
 
-    while (f_itr != free_buffers.end()) {
-        const Buffer& buffer = buffers[*f_itr];
-        if (buffer.status == Buffer::Status::Free && buffer.igbp_buffer.width == width &&
-            buffer.igbp_buffer.height == height) {
-            slot = *f_itr;
-            free_buffers.erase(f_itr);
-            break;
+        const Buffer& buffer = buffers[slot];
+        if (buffer.status != Buffer::Status::Free || buffer.igbp_buffer.width != width ||
+            buffer.igbp_buffer.height != height) {
+            continue;
         }
-        ++f_itr;
-    }
-    if (slot == buffers.size()) {
-        return std::nullopt;
+        if ((free_slots.fetch_and(~slot_bit, std::memory_order_acq_rel) & slot_bit) == 0) {
+            // Another thread claimed this slot first
+            continue;
+        }
+        buffers[slot].status = Buffer::Status::Dequeued;
+        return {{buffers[slot].slot, &buffers[slot].multi_fence}};
     }
-    buffers[slot].status = Buffer::Status::Dequeued;
-    return {{buffers[slot].slot, &buffers[slot].multi_fence}};
+    return std::nullopt;
 }
 
 const IGBPBuffer& BufferQueue::RequestBuffer(u32 slot) const {
@@ -100,8 +99,9 @@ void BufferQueue::QueueBuffer(u32 slot, BufferTransformFlags transform,
     buffers[slot].crop_rect = crop_rect;
     buffers[slot].swap_interval = swap_interval;
     buffers[slot].multi_fence = multi_fence;
-    std::unique_lock lock{queue_sequence_mutex};
-    queue_sequence.push_back(slot);
+    buffers[slot].frame_number = next_frame_number++;
+    buffers[slot].queue_time = std::chrono::steady_clock::now();
+    queued_slots.fetch_or(u64{1} << slot, std::memory_order_release);
 }
 
 void BufferQueue::CancelBuffer(u32 slot, const Service::Nvidia::MultiFence& multi_fence) {
@@ -109,37 +109,46 @@ void BufferQueue::CancelBuffer(u32 slot, const Service::Nvidia::MultiFence& mult
     ASSERT(buffers[slot].status != Buffer::Status::Free);
     ASSERT(buffers[slot].slot == slot);
 
+    queued_slots.fetch_and(~(u64{1} << slot), std::memory_order_acq_rel);
+
     buffers[slot].status = Buffer::Status::Free;
     buffers[slot].multi_fence = multi_fence;
     buffers[slot].swap_interval = 0;
-
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers.push_back(slot);
-    }
-    free_buffers_condition.notify_one();
+    FreeSlot(slot);
 
     buffer_wait_event.writable->Signal();
 }
 
 std::optional<std::reference_wrapper<const BufferQueue::Buffer>> BufferQueue::AcquireBuffer() {
-    std::unique_lock lock{queue_sequence_mutex};
-    std::size_t buffer_slot = buffers.size();
-    // Iterate to find a queued buffer matching the requested slot.
-    while (buffer_slot == buffers.size() && !queue_sequence.empty()) {
-        const auto slot = static_cast<std::size_t>(queue_sequence.front());
-        ASSERT(slot < buffers.size());
-        if (buffers[slot].status == Buffer::Status::Queued) {
-            ASSERT(buffers[slot].slot == slot);
-            buffer_slot = slot;
+    u64 queued = queued_slots.load(std::memory_order_acquire);
+    while (queued != 0) {
+        // Find the oldest queued buffer, queue order is given by the frame number.
+        u32 slot = static_cast<u32>(std::countr_zero(queued));
+        for (u64 mask = queued & (queued - 1); mask != 0; mask &= mask - 1) {
+            const auto other = static_cast<u32>(std::countr_zero(mask));
+            if (buffers[other].frame_number < buffers[slot].frame_number) {
+                slot = other;
+            }
         }
-        queue_sequence.pop_front();
-    }
-    if (buffer_slot == buffers.size()) {
-        return std::nullopt;
+        const u64 slot_bit = u64{1} << slot;
+        if ((queued_slots.fetch_and(~slot_bit, std::memory_order_acq_rel) & slot_bit) == 0 ||
+            buffers[slot].status != Buffer::Status::Queued) {
+            // The buffer was cancelled or the queue was reset while we were looking at it
+            queued = queued_slots.load(std::memory_order_acquire);
+            continue;
+        }
+        ASSERT(buffers[slot].slot == slot);
+
+        Buffer& buffer = buffers[slot];
+        buffer.status = Buffer::Status::Acquired;
+        LOG_TRACE(Service, "Frame pacing: layer_id={} slot={} frame={} queue_to_acquire={}us",
+                  layer_id, slot, buffer.frame_number,
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - buffer.queue_time)
+                      .count());
+        return {{buffer}};
     }
-    buffers[buffer_slot].status = Buffer::Status::Acquired;
-    return {{buffers[buffer_slot]}};
+    return std::nullopt;
 }
 
 void BufferQueue::ReleaseBuffer(u32 slot) {
@@ -148,30 +157,31 @@ void BufferQueue::ReleaseBuffer(u32 slot) {
     ASSERT(buffers[slot].slot == slot);
 
     buffers[slot].status = Buffer::Status::Free;
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers.push_back(slot);
-    }
-    free_buffers_condition.notify_one();
+    FreeSlot(slot);
 
     buffer_wait_event.writable->Signal();
 }
 
 void BufferQueue::Connect() {
-    std::unique_lock lock{queue_sequence_mutex};
-    queue_sequence.clear();
+    queued_slots.store(0, std::memory_order_release);
     is_connect = true;
 }
 
 void BufferQueue::Disconnect() {
     buffers.fill({});
-    {
-        std::unique_lock lock{queue_sequence_mutex};
-        queue_sequence.clear();
-    }
+    queued_slots.store(0, std::memory_order_release);
     buffer_wait_event.writable->Signal();
     is_connect = false;
-    free_buffers_condition.notify_one();
+
+    // Wake up any thread blocked in DequeueBuffer so it can observe the disconnection
+    free_slots_generation.fetch_add(1, std::memory_order_release);
+    free_slots_generation.notify_all();
+}
+
+void BufferQueue::FreeSlot(u32 slot) {
+    free_slots.fetch_or(u64{1} << slot, std::memory_order_release);
+    free_slots_generation.fetch_add(1, std::memory_order_release);
+    free_slots_generation.notify_one();
 }
 
 u32 BufferQueue::Query(QueryType type) {
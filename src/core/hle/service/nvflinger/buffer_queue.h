@@ -4,9 +4,9 @@
 
 #pragma once
 
-#include <condition_variable>
-#include <list>
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <optional>
 #include <vector>
 
@@ -24,6 +24,8 @@ class KernelCore;
 namespace Service::NVFlinger {
 
 constexpr u32 buffer_slots = 0x40;
+static_assert(buffer_slots <= 64, "Slot state is tracked in 64-bit masks");
+
 struct IGBPBuffer {
     u32_le magic;
     u32_le width;
@@ -89,6 +91,8 @@ public:
         Common::Rectangle<int> crop_rect;
         u32 swap_interval;
         Service::Nvidia::MultiFence multi_fence;
+        u64 frame_number;
+        std::chrono::steady_clock::time_point queue_time;
     };
 
     void SetPreallocatedBuffer(u32 slot, const IGBPBuffer& igbp_buffer);
@@ -124,15 +128,20 @@ private:
     u64 layer_id{};
     std::atomic_bool is_connect{};
 
-    std::list<u32> free_buffers;
+    /// Marks the slot as free and wakes up any thread waiting in DequeueBuffer.
+    void FreeSlot(u32 slot);
+
     std::array<Buffer, buffer_slots> buffers;
-    std::list<u32> queue_sequence;
     Kernel::EventPair buffer_wait_event;
 
-    std::mutex free_buffers_mutex;
-    std::condition_variable free_buffers_condition;
-
-    std::mutex queue_sequence_mutex;
+    /// Bitmask of slots that can be dequeued, one bit per entry in buffers.
+    std::atomic<u64> free_slots{};
+    /// Bitmask of slots that have been queued and not yet acquired.
+    std::atomic<u64> queued_slots{};
+    /// Incremented every time a slot is freed or the queue disconnects, used as a futex word.
+    std::atomic<u32> free_slots_generation{};
+    /// Frame number assigned to the next queued buffer, used to acquire in queue order.
+    u64 next_frame_number{};
 };
 
 } // namespace Service::NVFlinger
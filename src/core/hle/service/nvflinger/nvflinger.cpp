@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <optional>
 
 #include "common/assert.h"
@@ -30,6 +32,11 @@ namespace Service::NVFlinger {
 
 constexpr auto frame_ns = std::chrono::nanoseconds{1000000000 / 60};
 
+/// Number of previous compositions used to predict the cost of the next one
+constexpr std::size_t compose_history_size = 8;
+/// Extra time reserved ahead of the vsync deadline to absorb scheduling jitter
+constexpr s64 compose_margin_ns = 500000;
+
 void NVFlinger::VSyncThread(NVFlinger& nv_flinger) {
     nv_flinger.SplitVSync();
 }
@@ -44,20 +51,40 @@ void NVFlinger::SplitVSync() {
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
-    s64 delay = 0;
+
+    // Composition is started just in time for the vsync deadline, based on how long the most
+    // recent compositions took. Compose waits for the GPU to finish the frame, so this tracks the
+    // GPU frame time and keeps the guest vsync signal on a steady cadence.
+    std::array<s64, compose_history_size> compose_history{};
+    std::size_t compose_history_index = 0;
+    s64 deadline = system.CoreTiming().GetGlobalTimeNs().count();
     while (is_running) {
+        const s64 ticks = GetNextTicks();
+        const s64 predicted_cost =
+            *std::max_element(compose_history.begin(), compose_history.end()) + compose_margin_ns;
+        const s64 wake_time = deadline - std::min(predicted_cost, ticks);
+        const s64 now = system.CoreTiming().GetGlobalTimeNs().count();
+        if (wake_time > now) {
+            wait_event->WaitFor(std::chrono::nanoseconds{wake_time - now});
+            if (!is_running) {
+                break;
+            }
+        }
+
         guard->lock();
         const s64 time_start = system.CoreTiming().GetGlobalTimeNs().count();
         Compose();
-        const auto ticks = GetNextTicks();
         const s64 time_end = system.CoreTiming().GetGlobalTimeNs().count();
-        const s64 time_passed = time_end - time_start;
-        const s64 next_time = std::max<s64>(0, ticks - time_passed - delay);
         guard->unlock();
-        if (next_time > 0) {
-            wait_event->WaitFor(std::chrono::nanoseconds{next_time});
+
+        compose_history[compose_history_index] = time_end - time_start;
+        compose_history_index = (compose_history_index + 1) % compose_history.size();
+
+        deadline += GetNextTicks();
+        if (deadline < time_end) {
+            // We fell behind by more than a frame, resynchronize instead of composing in a burst
+            deadline = time_end + GetNextTicks();
         }
-        delay = (system.CoreTiming().GetGlobalTimeNs().count() - time_end) - next_time;
     }
 }
 
@@ -279,6 +306,9 @@ void NVFlinger::Compose() {
                      igbp_buffer.width, igbp_buffer.height, igbp_buffer.stride,
                      buffer->get().transform, buffer->get().crop_rect);
 
+        system.GetPerfStats().AddPresentLatency(std::chrono::steady_clock::now() -
+                                                buffer->get().queue_time);
+
         swap_interval = buffer->get().swap_interval;
         buffer_queue.ReleaseBuffer(buffer->get().slot);
     }
@@ -35,6 +35,9 @@ struct Memory::Impl {
 
         const std::size_t address_space_width = process.PageTable().GetAddressSpaceWidth();
 
+        current_page_table->fastmem_arena =
+            system.DeviceMemory().GetHostMemory().VirtualBasePointer();
+
         system.ArmInterface(core_id).PageTableChanged(*current_page_table, address_space_width);
     }
 
@@ -42,12 +45,16 @@ struct Memory::Impl {
         ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
         ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
         MapPages(page_table, base / PAGE_SIZE, size / PAGE_SIZE, target, Common::PageType::Memory);
+
+        system.DeviceMemory().GetHostMemory().Map(base, target - DramMemoryMap::Base, size);
     }
 
     void UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size) {
         ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
         ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
         MapPages(page_table, base / PAGE_SIZE, size / PAGE_SIZE, 0, Common::PageType::Unmapped);
+
+        system.DeviceMemory().GetHostMemory().Unmap(base, size);
     }
 
     bool IsValidVirtualAddress(const Kernel::Process& process, const VAddr vaddr) const {
@@ -82,6 +89,29 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    std::span<u8> GetContiguousSpan(const VAddr vaddr, const std::size_t size) const {
+        if (size == 0 || vaddr + size < vaddr) {
+            return {};
+        }
+        const u64 first_page = vaddr >> PAGE_BITS;
+        const u64 last_page = (vaddr + size - 1) >> PAGE_BITS;
+        if (last_page >= current_page_table->pointers.size()) {
+            return {};
+        }
+        // Page pointers are stored as offsets from the virtual address, pages that are contiguous
+        // on the host hold the same value
+        const uintptr_t raw_pointer = current_page_table->pointers[first_page].Raw();
+        if (Common::PageTable::PageInfo::ExtractType(raw_pointer) != Common::PageType::Memory) {
+            return {};
+        }
+        for (u64 page = first_page + 1; page <= last_page; ++page) {
+            if (current_page_table->pointers[page].Raw() != raw_pointer) {
+                return {};
+            }
+        }
+        return {Common::PageTable::PageInfo::ExtractPointer(raw_pointer) + vaddr, size};
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -471,6 +501,27 @@ struct Memory::Impl {
         // granularity of CPU pages, hence why we iterate on a CPU page basis (note: GPU page size
         // is different). This assumes the specified GPU address region is contiguous as well.
 
+        // Pages that switch type are also protected in the fastmem arena, cached pages fault so the
+        // JIT falls back to the slow path. Adjacent pages are batched to reduce the syscalls.
+        u64 protect_begin = 0;
+        u64 protect_size = 0;
+        const auto flush_protect = [&] {
+            if (protect_size != 0) {
+                system.DeviceMemory().GetHostMemory().Protect(protect_begin, protect_size, !cached,
+                                                              !cached);
+                protect_size = 0;
+            }
+        };
+        const auto protect_page = [&](VAddr page_addr) {
+            if (protect_size != 0 && protect_begin + protect_size == page_addr) {
+                protect_size += PAGE_SIZE;
+                return;
+            }
+            flush_protect();
+            protect_begin = page_addr;
+            protect_size = PAGE_SIZE;
+        };
+
         const u64 num_pages = ((vaddr + size - 1) >> PAGE_BITS) - (vaddr >> PAGE_BITS) + 1;
         for (u64 i = 0; i < num_pages; ++i, vaddr += PAGE_SIZE) {
             const Common::PageType page_type{
@@ -485,6 +536,7 @@ struct Memory::Impl {
                 case Common::PageType::Memory:
                     current_page_table->pointers[vaddr >> PAGE_BITS].Store(
                         nullptr, Common::PageType::RasterizerCachedMemory);
+                    protect_page(vaddr & ~PAGE_MASK);
                     break;
                 case Common::PageType::RasterizerCachedMemory:
                     // There can be more than one GPU region mapped per CPU region, so it's common
@@ -515,6 +567,7 @@ struct Memory::Impl {
                     } else {
                         current_page_table->pointers[vaddr >> PAGE_BITS].Store(
                             pointer - (vaddr & ~PAGE_MASK), Common::PageType::Memory);
+                        protect_page(vaddr & ~PAGE_MASK);
                     }
                     break;
                 }
@@ -523,6 +576,7 @@ struct Memory::Impl {
                 }
             }
         }
+        flush_protect();
     }
 
     /**
@@ -745,6 +799,10 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+std::span<u8> Memory::GetContiguousSpan(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousSpan(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
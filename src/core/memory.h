@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
 #include "common/common_types.h"
 
@@ -126,6 +127,18 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a host span over a range of the current process' address space, which can be written
+     * to directly without any rasterizer cache maintenance.
+     *
+     * @param vaddr Virtual address at the start of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The span over the range if every page of it is regular memory and the pages are
+     *          contiguous in host memory. Otherwise an empty span is returned.
+     */
+    std::span<u8> GetContiguousSpan(VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -44,6 +44,17 @@ PerfStats::~PerfStats() {
         fmt::format("{}/{:%F-%H-%M}_{:016X}.csv", path, *std::localtime(&t), title_id);
     Common::FS::IOFile file(filename, "w");
     file.WriteString(stream.str());
+
+    // Present latency distribution, one line per 1 ms bucket: "<bucket start in ms>,<frames>"
+    std::ostringstream latency_stream;
+    for (std::size_t bucket = 0; bucket < present_latency_histogram.size(); ++bucket) {
+        latency_stream << bucket << ',' << present_latency_histogram[bucket] << '\n';
+    }
+    const std::string latency_filename =
+        fmt::format("{}/{:%F-%H-%M}_{:016X}_present_latency.csv", path, *std::localtime(&t),
+                    title_id);
+    Common::FS::IOFile latency_file(latency_filename, "w");
+    latency_file.WriteString(latency_stream.str());
 }
 
 void PerfStats::BeginSystemFrame() {
@@ -74,6 +85,16 @@ void PerfStats::EndGameFrame() {
     game_frames += 1;
 }
 
+void PerfStats::AddPresentLatency(std::chrono::nanoseconds latency) {
+    std::lock_guard lock{object_mutex};
+
+    const auto bucket = static_cast<std::size_t>(
+        std::max<s64>(0, std::chrono::duration_cast<std::chrono::milliseconds>(latency).count()));
+    present_latency_histogram[std::min(bucket, PresentLatencyBuckets - 1)] += 1;
+    accumulated_present_latency += latency;
+    present_latency_frames += 1;
+}
+
 double PerfStats::GetMeanFrametime() const {
     std::lock_guard lock{object_mutex};
 
@@ -101,6 +122,10 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
         .frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                      static_cast<double>(system_frames),
         .emulation_speed = system_us_per_second.count() / 1'000'000.0,
+        .present_latency = present_latency_frames == 0
+                               ? 0.0
+                               : duration_cast<DoubleSecs>(accumulated_present_latency).count() /
+                                     static_cast<double>(present_latency_frames),
     };
 
     // Reset counters
@@ -109,6 +134,8 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     game_frames = 0;
+    accumulated_present_latency = std::chrono::nanoseconds::zero();
+    present_latency_frames = 0;
 
     return results;
 }
@@ -21,8 +21,14 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Mean time between a game frame being queued and it being presented, in seconds
+    double present_latency;
 };
 
+/// Number of 1 ms wide buckets in the present latency histogram, the last bucket holds outliers
+constexpr std::size_t PresentLatencyBuckets = 34;
+using PresentLatencyHistogram = std::array<u32, PresentLatencyBuckets>;
+
 /**
  * Class to manage and query performance/timing statistics. All public functions of this class are
  * thread-safe unless stated otherwise.
@@ -38,6 +44,9 @@ public:
     void EndSystemFrame();
     void EndGameFrame();
 
+    /// Records the time a game frame spent between being queued and being presented.
+    void AddPresentLatency(std::chrono::nanoseconds latency);
+
     PerfStatsResults GetAndResetStats(std::chrono::microseconds current_system_time_us);
 
     /**
@@ -73,6 +82,12 @@ private:
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     u32 game_frames = 0;
+    /// Cumulative present latency of the frames presented since last reset
+    std::chrono::nanoseconds accumulated_present_latency{0};
+    /// Number of frames that contributed to accumulated_present_latency
+    u32 present_latency_frames = 0;
+    /// Present latency distribution since the game started
+    PresentLatencyHistogram present_latency_histogram{};
 
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
@@ -23,6 +23,7 @@ namespace Settings {
 enum class RendererBackend {
     OpenGL = 0,
     Vulkan = 1,
+    Null = 2,
 };
 
 enum class GPUAccuracy : u32 {
@@ -128,6 +129,7 @@ struct Values {
     bool cpuopt_const_prop;
     bool cpuopt_misc_ir;
     bool cpuopt_reduce_misalign_checks;
+    bool cpuopt_fastmem{true};
 
     bool cpuopt_unsafe_unfuse_fma;
     bool cpuopt_unsafe_reduce_fp_error;
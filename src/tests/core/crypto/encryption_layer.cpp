@@ -0,0 +1,102 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/key_manager.h"
+#include "core/crypto/xts_encryption_layer.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using namespace Core::Crypto;
+
+constexpr std::size_t DATA_SIZE = 0x40000;
+constexpr std::size_t NUM_THREADS = 4;
+constexpr std::size_t READS_PER_THREAD = 256;
+
+std::vector<u8> MakePlaintext() {
+    std::mt19937 rng{0x5EED};
+    std::vector<u8> data(DATA_SIZE);
+    std::generate(data.begin(), data.end(), [&rng] { return static_cast<u8>(rng()); });
+    return data;
+}
+
+template <typename Key>
+Key MakeKey(u8 seed) {
+    Key key{};
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(seed + i * 7);
+    }
+    return key;
+}
+
+/// Reads random ranges of layer from several threads at once, returns true when every read
+/// matched plaintext
+bool ReadConcurrently(const FileSys::VirtualFile& layer, const std::vector<u8>& plaintext) {
+    std::atomic<bool> matches{true};
+    std::vector<std::thread> threads;
+    for (std::size_t thread_index = 0; thread_index < NUM_THREADS; ++thread_index) {
+        threads.emplace_back([&, thread_index] {
+            std::mt19937 rng{static_cast<u32>(thread_index)};
+            std::vector<u8> buffer;
+            for (std::size_t i = 0; i < READS_PER_THREAD && matches; ++i) {
+                const std::size_t offset = rng() % (DATA_SIZE - 1);
+                const std::size_t max_length = std::min<std::size_t>(DATA_SIZE - offset, 0x9000);
+                const std::size_t length = 1 + rng() % max_length;
+                buffer.assign(length, 0);
+                if (layer->Read(buffer.data(), length, offset) != length ||
+                    std::memcmp(buffer.data(), plaintext.data() + offset, length) != 0) {
+                    matches = false;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return matches;
+}
+} // Anonymous namespace
+
+TEST_CASE("CTREncryptionLayer: Concurrent reads decrypt with their own counter", "[core]") {
+    const auto plaintext = MakePlaintext();
+    const auto key = MakeKey<Key128>(0x10);
+    CTREncryptionLayer::IVData iv{};
+    std::fill_n(iv.begin(), 8, u8{0xA5});
+
+    std::vector<u8> ciphertext(DATA_SIZE);
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    cipher.SetIV(iv);
+    cipher.Transcode(plaintext.data(), plaintext.size(), ciphertext.data(), Op::Encrypt);
+
+    const auto layer = std::make_shared<CTREncryptionLayer>(
+        std::make_shared<FileSys::VectorVfsFile>(std::move(ciphertext)), key, 0);
+    layer->SetIV(iv);
+    REQUIRE(ReadConcurrently(layer, plaintext));
+}
+
+TEST_CASE("XTSEncryptionLayer: Concurrent reads decrypt with their own tweak", "[core]") {
+    const auto plaintext = MakePlaintext();
+    const auto key = MakeKey<Key256>(0x20);
+
+    std::vector<u8> ciphertext(DATA_SIZE);
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    cipher.XTSTranscode(plaintext.data(), plaintext.size(), ciphertext.data(), 0, 0x4000,
+                        Op::Encrypt);
+
+    const auto layer = std::make_shared<XTSEncryptionLayer>(
+        std::make_shared<FileSys::VectorVfsFile>(std::move(ciphertext)), key);
+    REQUIRE(ReadConcurrently(layer, plaintext));
+}
@@ -0,0 +1,62 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs_layered.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using namespace FileSys;
+
+VirtualFile MakeFile(std::string name, u8 value) {
+    return std::make_shared<VectorVfsFile>(std::vector<u8>{value}, std::move(name));
+}
+
+VirtualDir MakeDir(std::string name, std::vector<VirtualFile> files,
+                   std::vector<VirtualDir> dirs = {}) {
+    return std::make_shared<VectorVfsDirectory>(std::move(files), std::move(dirs),
+                                                std::move(name));
+}
+
+u8 ReadValue(const VirtualFile& file) {
+    REQUIRE(file != nullptr);
+    return file->ReadBytes(1)[0];
+}
+} // Anonymous namespace
+
+TEST_CASE("LayeredVfsDirectory: Lookups resolve to the highest priority layer", "[core]") {
+    const auto mod = MakeDir("mod", {MakeFile("main", 1)},
+                             {MakeDir("data", {MakeFile("a.bin", 1)},
+                                      {MakeDir("sub", {MakeFile("b.bin", 1)})})});
+    const auto base = MakeDir("base", {MakeFile("main", 0), MakeFile("main.npdm", 0)},
+                              {MakeDir("data", {MakeFile("a.bin", 0), MakeFile("c.bin", 0)})});
+    const auto layered = LayeredVfsDirectory::MakeLayeredDirectory({mod, base});
+
+    REQUIRE(ReadValue(layered->GetFile("main")) == 1);
+    REQUIRE(ReadValue(layered->GetFile("main.npdm")) == 0);
+    REQUIRE(ReadValue(layered->GetFileRelative("/data//a.bin")) == 1);
+    REQUIRE(ReadValue(layered->GetFileRelative("data\\c.bin")) == 0);
+    REQUIRE(ReadValue(layered->GetFileRelative("data/sub/b.bin")) == 1);
+    REQUIRE(layered->GetFileRelative("data/missing.bin") == nullptr);
+    REQUIRE(layered->GetFileRelative("data") == nullptr);
+    REQUIRE(layered->GetDirectoryRelative("main") == nullptr);
+
+    // Subdirectories present in several layers share the index of their root
+    const auto data = layered->GetSubdirectory("data");
+    REQUIRE(data != nullptr);
+    REQUIRE(ReadValue(data->GetFile("a.bin")) == 1);
+    REQUIRE(ReadValue(data->GetFile("c.bin")) == 0);
+    REQUIRE(ReadValue(data->GetFileRelative("sub/b.bin")) == 1);
+    REQUIRE(data->GetFiles().size() == 2);
+
+    // Subdirectories present in a single layer are returned as is
+    REQUIRE(data->GetSubdirectory("sub") != nullptr);
+    REQUIRE(ReadValue(data->GetSubdirectory("sub")->GetFile("b.bin")) == 1);
+}
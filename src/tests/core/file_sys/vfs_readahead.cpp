@@ -0,0 +1,166 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs_readahead.h"
+
+namespace {
+using namespace FileSys;
+
+constexpr std::size_t BLOCK_SIZE = ReadaheadScheduler::BLOCK_SIZE;
+constexpr std::size_t NUM_BLOCKS = 24;
+
+/// Read-only file whose contents can be replaced, records which whole blocks were read from it
+class RecordingVfsFile final : public VfsFile {
+public:
+    RecordingVfsFile() : data(NUM_BLOCKS * BLOCK_SIZE, 1) {}
+
+    std::string GetName() const override {
+        return "recording";
+    }
+
+    std::size_t GetSize() const override {
+        return data.size();
+    }
+
+    bool Resize(std::size_t new_size) override {
+        return false;
+    }
+
+    VirtualDir GetContainingDirectory() const override {
+        return nullptr;
+    }
+
+    bool IsWritable() const override {
+        return false;
+    }
+
+    bool IsReadable() const override {
+        return true;
+    }
+
+    std::size_t Read(u8* out, std::size_t length, std::size_t offset) const override {
+        std::scoped_lock lock{mutex};
+        const std::size_t read_size = std::min(length, data.size() - offset);
+        std::memcpy(out, data.data() + offset, read_size);
+        if (offset % BLOCK_SIZE == 0 && length == BLOCK_SIZE) {
+            block_reads.insert(offset / BLOCK_SIZE);
+            cv.notify_all();
+        }
+        return read_size;
+    }
+
+    std::size_t Write(const u8* in, std::size_t length, std::size_t offset) override {
+        return 0;
+    }
+
+    bool Rename(std::string_view name) override {
+        return false;
+    }
+
+    /// Replaces every byte of the file with value
+    void Fill(u8 value) {
+        std::scoped_lock lock{mutex};
+        std::fill(data.begin(), data.end(), value);
+    }
+
+    /// Waits until blocks [first, first + count) have been read whole, returns false on timeout
+    bool WaitForBlockReads(std::size_t first, std::size_t count) const {
+        std::unique_lock lock{mutex};
+        return cv.wait_for(lock, std::chrono::seconds{5}, [&] {
+            for (std::size_t index = first; index < first + count; ++index) {
+                if (!block_reads.contains(index)) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+private:
+    std::vector<u8> data;
+    mutable std::mutex mutex;
+    mutable std::condition_variable cv;
+    mutable std::set<std::size_t> block_reads;
+};
+
+/// Reads length bytes at offset and returns true when all of them are value
+bool ReadEquals(const VirtualFile& file, std::size_t length, std::size_t offset, u8 value) {
+    std::vector<u8> buffer(length);
+    if (file->Read(buffer.data(), length, offset) != length) {
+        return false;
+    }
+    return std::all_of(buffer.begin(), buffer.end(), [value](u8 byte) { return byte == value; });
+}
+
+/// Reads the first four blocks sequentially, which prefetches blocks 4 to 11
+void StartSequentialStream(const VirtualFile& file) {
+    REQUIRE(ReadEquals(file, 16, 0, 1));
+    REQUIRE(ReadEquals(file, 4 * BLOCK_SIZE - 16, 16, 1));
+}
+} // Anonymous namespace
+
+TEST_CASE("ReadaheadScheduler: Sequential reads are served from prefetched blocks", "[core]") {
+    const auto scheduler = std::make_shared<ReadaheadScheduler>(1, 16 * BLOCK_SIZE);
+    const auto backing = std::make_shared<RecordingVfsFile>();
+    const auto file = scheduler->Wrap(backing);
+
+    StartSequentialStream(file);
+    REQUIRE(backing->WaitForBlockReads(4, ReadaheadScheduler::WINDOW_BLOCKS));
+    REQUIRE(scheduler->NumCachedBlocks() == ReadaheadScheduler::WINDOW_BLOCKS);
+
+    // Data changed after the prefetch is only seen by accesses that bypass the cache
+    backing->Fill(2);
+    REQUIRE(ReadEquals(file, BLOCK_SIZE, 4 * BLOCK_SIZE, 1));
+    REQUIRE(ReadEquals(file, 16, 6 * BLOCK_SIZE + 16, 2));
+}
+
+TEST_CASE("ReadaheadScheduler: Least recently used blocks are evicted first", "[core]") {
+    const auto scheduler = std::make_shared<ReadaheadScheduler>(1, 4 * BLOCK_SIZE);
+    const auto backing = std::make_shared<RecordingVfsFile>();
+    const auto file = scheduler->Wrap(backing);
+
+    // Prefetching eight blocks into a four block cache keeps the last four
+    StartSequentialStream(file);
+    REQUIRE(backing->WaitForBlockReads(4, ReadaheadScheduler::WINDOW_BLOCKS));
+    REQUIRE(scheduler->NumCachedBlocks() == 4);
+    backing->Fill(2);
+
+    // A random access followed by a sequential one reaches the cache again
+    REQUIRE(ReadEquals(file, 16, 11 * BLOCK_SIZE - 16, 2));
+    REQUIRE(ReadEquals(file, 16, 11 * BLOCK_SIZE, 1));
+
+    REQUIRE(ReadEquals(file, 16, 4 * BLOCK_SIZE - 16, 2));
+    REQUIRE(ReadEquals(file, 16, 4 * BLOCK_SIZE, 2));
+    REQUIRE(scheduler->NumCachedBlocks() <= 4);
+}
+
+TEST_CASE("ReadaheadScheduler: Closing a file drops its blocks", "[core]") {
+    const auto scheduler = std::make_shared<ReadaheadScheduler>(1, 32 * BLOCK_SIZE);
+    const auto backing_a = std::make_shared<RecordingVfsFile>();
+    const auto backing_b = std::make_shared<RecordingVfsFile>();
+    auto file_a = scheduler->Wrap(backing_a);
+    const auto file_b = scheduler->Wrap(backing_b);
+
+    StartSequentialStream(file_a);
+    StartSequentialStream(file_b);
+    REQUIRE(backing_a->WaitForBlockReads(4, ReadaheadScheduler::WINDOW_BLOCKS));
+    REQUIRE(backing_b->WaitForBlockReads(4, ReadaheadScheduler::WINDOW_BLOCKS));
+    REQUIRE(scheduler->NumCachedBlocks() == 2 * ReadaheadScheduler::WINDOW_BLOCKS);
+
+    file_a.reset();
+    REQUIRE(scheduler->NumCachedBlocks() == ReadaheadScheduler::WINDOW_BLOCKS);
+}
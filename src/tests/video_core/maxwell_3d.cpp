@@ -0,0 +1,114 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <numeric>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/memory_manager.h"
+
+namespace {
+using Tegra::Engines::Maxwell3D;
+
+constexpr u32 NUM_ARGUMENTS = 64;
+
+struct Engines {
+    Engines()
+        : memory_manager{system}, batched{std::make_unique<Maxwell3D>(system, memory_manager)},
+          single{std::make_unique<Maxwell3D>(system, memory_manager)} {
+        // Spread the registers over a few dirty flags so the tracking can be compared
+        for (u32 method = 0; method < Maxwell3D::Regs::NUM_REGS; ++method) {
+            const u8 flag = static_cast<u8>(1 + method % 32);
+            batched->dirty.tables[0][method] = flag;
+            single->dirty.tables[0][method] = flag;
+        }
+        batched->dirty.flags.reset();
+        single->dirty.flags.reset();
+    }
+
+    void Call(u32 method, const u32* arguments, u32 amount) {
+        batched->CallMethodRange(method, arguments, amount, amount);
+        for (u32 i = 0; i < amount; ++i) {
+            single->CallMethod(method + i, arguments[i], amount - i <= 1);
+        }
+    }
+
+    [[nodiscard]] bool Equal() const {
+        return std::memcmp(&batched->regs, &single->regs, sizeof(Maxwell3D::Regs)) == 0 &&
+               std::memcmp(&batched->shadow_state, &single->shadow_state,
+                           sizeof(Maxwell3D::Regs)) == 0 &&
+               batched->dirty.flags == single->dirty.flags;
+    }
+
+    Core::System system;
+    Tegra::MemoryManager memory_manager;
+    std::unique_ptr<Maxwell3D> batched;
+    std::unique_ptr<Maxwell3D> single;
+};
+} // Anonymous namespace
+
+TEST_CASE("Maxwell3D: Register ranges match single writes", "[video_core]") {
+    Engines engines;
+    std::array<u32, NUM_ARGUMENTS> arguments;
+    std::iota(arguments.begin(), arguments.end(), 0x1000U);
+
+    engines.Call(MAXWELL3D_REG_INDEX(vertex_attrib_format), arguments.data(), NUM_ARGUMENTS);
+    REQUIRE(engines.Equal());
+    REQUIRE(engines.batched->dirty.flags.any());
+
+    // Rewriting the same values must not dirty anything
+    engines.batched->dirty.flags.reset();
+    engines.single->dirty.flags.reset();
+    engines.Call(MAXWELL3D_REG_INDEX(vertex_attrib_format), arguments.data(), NUM_ARGUMENTS);
+    REQUIRE(engines.Equal());
+    REQUIRE(engines.batched->dirty.flags.none());
+}
+
+TEST_CASE("Maxwell3D: Register ranges split at side effects", "[video_core]") {
+    Engines engines;
+    constexpr u32 passthrough = static_cast<u32>(Maxwell3D::Regs::ShadowRamControl::Passthrough);
+    // upload_address, data, entry, bind, shadow_ram_control and the padding that follows
+    const std::array<u32, 8> arguments{0, 0xDEADBEEF, 3, 0, passthrough, 1, 2, 3};
+    engines.Call(MAXWELL3D_REG_INDEX(macros.upload_address), arguments.data(),
+                 static_cast<u32>(arguments.size()));
+    REQUIRE(engines.Equal());
+    REQUIRE(engines.batched->shadow_state.shadow_ram_control ==
+            Maxwell3D::Regs::ShadowRamControl::Passthrough);
+}
+
+TEST_CASE("Maxwell3D: Register range throughput", "[.][benchmark]") {
+    Engines engines;
+    std::array<u32, NUM_ARGUMENTS> arguments;
+    constexpr u32 method = MAXWELL3D_REG_INDEX(vertex_attrib_format);
+    constexpr u32 iterations = 100000;
+
+    const auto measure = [&](auto&& call) {
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 iteration = 0; iteration < iterations; ++iteration) {
+            // Change the values every iteration so the writes are never redundant
+            arguments.fill(iteration);
+            call();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(iterations) * NUM_ARGUMENTS / elapsed.count();
+    };
+    const double single_rate = measure([&] {
+        for (u32 i = 0; i < NUM_ARGUMENTS; ++i) {
+            engines.single->CallMethod(method + i, arguments[i], NUM_ARGUMENTS - i <= 1);
+        }
+    });
+    const double batched_rate = measure([&] {
+        engines.batched->CallMethodRange(method, arguments.data(), NUM_ARGUMENTS, NUM_ARGUMENTS);
+    });
+    WARN("Single methods: " << single_rate << " methods/s, ranges: " << batched_rate
+                            << " methods/s");
+    REQUIRE(engines.Equal());
+}
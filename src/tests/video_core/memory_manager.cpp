@@ -0,0 +1,137 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace {
+constexpr u64 PAGE = 0x10000;
+constexpr u64 BIG_PAGE = 0x200000;
+constexpr VAddr CPU_ADDR = 0x80000000;
+
+/// Rasterizer that records the ranges unmapped through the memory manager
+class UnmapRecorder final : public VideoCore::RasterizerInterface {
+public:
+    void Draw(bool, bool) override {}
+    void Clear() override {}
+    void DispatchCompute(GPUVAddr) override {}
+    void ResetCounter(VideoCore::QueryType) override {}
+    void Query(GPUVAddr, VideoCore::QueryType, std::optional<u64>) override {}
+    void BindGraphicsUniformBuffer(size_t, u32, GPUVAddr, u32) override {}
+    void SignalSemaphore(GPUVAddr, u32) override {}
+    void SignalSyncPoint(u32) override {}
+    void ReleaseFences() override {}
+    void FlushAll() override {}
+    void FlushRegion(VAddr, u64) override {}
+    void InvalidateExceptTextureCache(VAddr, u64) override {}
+    void InvalidateTextureCache(VAddr, u64) override {}
+    bool MustFlushRegion(VAddr, u64) override {
+        return false;
+    }
+    void InvalidateRegion(VAddr, u64) override {}
+    void OnCPUWrite(VAddr, u64) override {}
+    void AccelerateInlineToMemory(GPUVAddr, size_t, std::span<const u8>) override {}
+    void SyncGuestHost() override {}
+    void UnmapMemory(VAddr addr, u64 size) override {
+        unmapped.emplace_back(addr, size);
+    }
+    void FlushAndInvalidateRegion(VAddr, u64) override {}
+    void WaitForIdle() override {}
+    void FragmentBarrier() override {}
+    void TiledCacheBarrier() override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+
+    std::vector<std::pair<VAddr, u64>> unmapped;
+};
+} // Anonymous namespace
+
+TEST_CASE("MemoryManager: Contiguous mappings translate across big pages", "[video_core]") {
+    Core::System system;
+    Tegra::MemoryManager memory_manager{system};
+    constexpr std::size_t size = BIG_PAGE * 3 + PAGE;
+    const GPUVAddr gpu_addr = memory_manager.MapAllocate(CPU_ADDR, size, 0);
+    REQUIRE(gpu_addr == 1ULL << 32);
+
+    for (const u64 offset : {u64{0}, PAGE - 4, BIG_PAGE - 4, BIG_PAGE, BIG_PAGE * 3 + 4}) {
+        REQUIRE(memory_manager.GpuToCpuAddress(gpu_addr + offset) == CPU_ADDR + offset);
+    }
+    REQUIRE(!memory_manager.GpuToCpuAddress(gpu_addr + size));
+
+    // The next allocation must start after the previous one
+    const GPUVAddr next_addr = memory_manager.MapAllocate(CPU_ADDR, PAGE, 0);
+    REQUIRE(next_addr == gpu_addr + size);
+    REQUIRE(!memory_manager.AllocateFixed(gpu_addr + BIG_PAGE, PAGE));
+}
+
+TEST_CASE("MemoryManager: Small mappings inside a big page", "[video_core]") {
+    Core::System system;
+    Tegra::MemoryManager memory_manager{system};
+    const GPUVAddr gpu_addr = memory_manager.Allocate(BIG_PAGE * 2, BIG_PAGE);
+    REQUIRE(gpu_addr % BIG_PAGE == 0);
+
+    // Map two discontiguous pages in the middle of an allocated big page
+    const GPUVAddr first = gpu_addr + BIG_PAGE + PAGE * 4;
+    REQUIRE(memory_manager.Map(CPU_ADDR, first, PAGE) == first);
+    REQUIRE(memory_manager.Map(CPU_ADDR + BIG_PAGE, first + PAGE, PAGE) == first + PAGE);
+
+    REQUIRE(memory_manager.GpuToCpuAddress(first + 8) == CPU_ADDR + 8);
+    REQUIRE(memory_manager.GpuToCpuAddress(first + PAGE + 8) == CPU_ADDR + BIG_PAGE + 8);
+    REQUIRE(!memory_manager.GpuToCpuAddress(first - PAGE));
+    REQUIRE(!memory_manager.GpuToCpuAddress(gpu_addr));
+
+    // Allocated pages are not free
+    REQUIRE(!memory_manager.AllocateFixed(first + PAGE * 2, PAGE));
+    REQUIRE(memory_manager.Allocate(PAGE, 0) == gpu_addr + BIG_PAGE * 2);
+}
+
+TEST_CASE("MemoryManager: 32-bit allocations", "[video_core]") {
+    Core::System system;
+    Tegra::MemoryManager memory_manager{system};
+    const GPUVAddr gpu_addr = memory_manager.MapAllocate32(CPU_ADDR, BIG_PAGE);
+    REQUIRE(gpu_addr >= PAGE);
+    REQUIRE(gpu_addr + BIG_PAGE <= 1ULL << 32);
+    REQUIRE(memory_manager.GpuToCpuAddress(gpu_addr + BIG_PAGE - 1) == CPU_ADDR + BIG_PAGE - 1);
+}
+
+TEST_CASE("MemoryManager: Unmapping a split big page releases its small page table",
+          "[video_core]") {
+    Core::System system;
+    Tegra::MemoryManager memory_manager{system};
+    UnmapRecorder rasterizer;
+    memory_manager.BindRasterizer(&rasterizer);
+
+    const GPUVAddr gpu_addr = memory_manager.Allocate(BIG_PAGE, BIG_PAGE);
+    REQUIRE(gpu_addr % BIG_PAGE == 0);
+
+    // Remapping part of a big page mapping splits it into a small page table
+    const GPUVAddr other_addr = gpu_addr + PAGE * 3;
+    REQUIRE(memory_manager.Map(CPU_ADDR, gpu_addr, BIG_PAGE) == gpu_addr);
+    REQUIRE(memory_manager.Map(CPU_ADDR + BIG_PAGE, other_addr, PAGE) == other_addr);
+    REQUIRE(memory_manager.GpuToCpuAddress(gpu_addr + 8) == CPU_ADDR + 8);
+    REQUIRE(memory_manager.GpuToCpuAddress(other_addr + 8) == CPU_ADDR + BIG_PAGE + 8);
+
+    // Unmapping the whole big page releases the small page table
+    memory_manager.Unmap(gpu_addr, BIG_PAGE);
+    REQUIRE(rasterizer.unmapped.size() == 1);
+    REQUIRE(rasterizer.unmapped[0] == std::make_pair(CPU_ADDR, BIG_PAGE));
+    REQUIRE(!memory_manager.GpuToCpuAddress(gpu_addr + 8));
+    REQUIRE(!memory_manager.GpuToCpuAddress(other_addr + 8));
+    REQUIRE(memory_manager.AllocateFixed(gpu_addr, BIG_PAGE) == gpu_addr);
+
+    // Splitting the big page again must not bring back entries of the released table
+    const GPUVAddr next_addr = gpu_addr + PAGE * 5;
+    REQUIRE(memory_manager.Map(CPU_ADDR, next_addr, PAGE) == next_addr);
+    REQUIRE(memory_manager.GpuToCpuAddress(next_addr + 8) == CPU_ADDR + 8);
+    REQUIRE(!memory_manager.GpuToCpuAddress(other_addr + 8));
+}
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -107,6 +108,11 @@ public:
 
     void DownloadMemory(VAddr cpu_addr, u64 size);
 
+    /// Upload data written to guest memory from the command stream directly into the buffer
+    /// holding it. Returns false when no buffer fully contains the region.
+    [[nodiscard]] bool InlineMemory(VAddr cpu_addr, size_t copy_size,
+                                    std::span<const u8> inlined_buffer);
+
     void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr, u32 size);
 
     void UpdateGraphicsBuffers(bool is_indexed);
@@ -138,14 +144,11 @@ public:
     /// Return true when there are uncommitted buffers to be downloaded
     [[nodiscard]] bool HasUncommittedFlushes() const noexcept;
 
-    /// Return true when the caller should wait for async downloads
-    [[nodiscard]] bool ShouldWaitAsyncFlushes() const noexcept;
-
-    /// Commit asynchronous downloads
-    void CommitAsyncFlushes();
+    /// Commit asynchronous downloads, to be performed once the given fence is released
+    void CommitAsyncFlushes(u64 fence_value);
 
-    /// Pop asynchronous downloads
-    void PopAsyncFlushes();
+    /// Perform the asynchronous downloads committed up to the given fence
+    void PopAsyncFlushes(u64 fence_value);
 
     /// Return true when a CPU region is modified from the GPU
     [[nodiscard]] bool IsRegionGpuModified(VAddr addr, size_t size);
@@ -258,6 +261,8 @@ private:
 
     void NotifyBufferDeletion();
 
+    void DownloadBuffers(std::span<const BufferId> download_ids);
+
     [[nodiscard]] Binding StorageBufferBinding(GPUVAddr ssbo_addr) const;
 
     [[nodiscard]] std::span<const u8> ImmediateBufferWithData(VAddr cpu_addr, size_t size);
@@ -306,7 +311,7 @@ private:
 
     // TODO: This data structure is not optimal and it should be reworked
     std::vector<BufferId> uncommitted_downloads;
-    std::deque<std::vector<BufferId>> committed_downloads;
+    std::deque<std::pair<u64, std::vector<BufferId>>> committed_downloads;
 
     size_t immediate_buffer_capacity = 0;
     std::unique_ptr<u8[]> immediate_buffer_alloc;
@@ -396,6 +401,37 @@ void BufferCache<P>::DownloadMemory(VAddr cpu_addr, u64 size) {
     });
 }
 
+template <class P>
+bool BufferCache<P>::InlineMemory(VAddr cpu_addr, size_t copy_size,
+                                  std::span<const u8> inlined_buffer) {
+    const BufferId buffer_id = page_table[cpu_addr >> PAGE_BITS];
+    if (!buffer_id) {
+        return false;
+    }
+    Buffer& buffer = slot_buffers[buffer_id];
+    if (!buffer.IsInBounds(cpu_addr, copy_size)) {
+        return false;
+    }
+    if (buffer.IsRegionCpuModified(cpu_addr, copy_size)) {
+        // The region is going to be uploaded from guest memory anyway
+        return false;
+    }
+    const u32 offset = buffer.Offset(cpu_addr);
+    if constexpr (USE_MEMORY_MAPS) {
+        auto upload_staging = runtime.UploadStagingBuffer(copy_size);
+        std::memcpy(upload_staging.mapped_span.data(), inlined_buffer.data(), copy_size);
+        const std::array copies{BufferCopy{
+            .src_offset = upload_staging.offset,
+            .dst_offset = offset,
+            .size = copy_size,
+        }};
+        runtime.CopyBuffer(buffer, upload_staging.buffer, copies);
+    } else {
+        buffer.ImmediateUpload(offset, inlined_buffer.first(copy_size));
+    }
+    return true;
+}
+
 template <class P>
 void BufferCache<P>::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
                                                u32 size) {
@@ -525,27 +561,24 @@ bool BufferCache<P>::HasUncommittedFlushes() const noexcept {
 }
 
 template <class P>
-bool BufferCache<P>::ShouldWaitAsyncFlushes() const noexcept {
-    return !committed_downloads.empty() && !committed_downloads.front().empty();
+void BufferCache<P>::CommitAsyncFlushes(u64 fence_value) {
+    if (uncommitted_downloads.empty()) {
+        return;
+    }
+    committed_downloads.emplace_back(fence_value, std::move(uncommitted_downloads));
+    uncommitted_downloads.clear();
 }
 
 template <class P>
-void BufferCache<P>::CommitAsyncFlushes() {
-    // This is intentionally passing the value by copy
-    committed_downloads.push_front(uncommitted_downloads);
-    uncommitted_downloads.clear();
+void BufferCache<P>::PopAsyncFlushes(u64 fence_value) {
+    while (!committed_downloads.empty() && committed_downloads.front().first <= fence_value) {
+        DownloadBuffers(committed_downloads.front().second);
+        committed_downloads.pop_front();
+    }
 }
 
 template <class P>
-void BufferCache<P>::PopAsyncFlushes() {
-    if (committed_downloads.empty()) {
-        return;
-    }
-    auto scope_exit_pop_download = detail::ScopeExit([this] { committed_downloads.pop_back(); });
-    const std::span<const BufferId> download_ids = committed_downloads.back();
-    if (download_ids.empty()) {
-        return;
-    }
+void BufferCache<P>::DownloadBuffers(std::span<const BufferId> download_ids) {
     MICROPROFILE_SCOPE(GPU_DownloadMemory);
 
     boost::container::small_vector<std::pair<BufferCopy, BufferId>, 1> downloads;
@@ -1218,7 +1251,9 @@ void BufferCache<P>::ReplaceBufferDownloads(BufferId old_buffer_id, BufferId new
         }
     };
     replace(uncommitted_downloads);
-    std::ranges::for_each(committed_downloads, replace);
+    for (auto& [fence_value, download_ids] : committed_downloads) {
+        replace(download_ids);
+    }
 }
 
 template <class P>
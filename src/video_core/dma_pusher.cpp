@@ -8,7 +8,9 @@
 #include "core/memory.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 
 namespace Tegra {
@@ -33,6 +35,7 @@ void DmaPusher::DispatchCalls() {
             break;
         }
     }
+    gpu.MaxwellDMA().WaitPendingCopy();
     gpu.FlushCommands();
     gpu.SyncGuestHost();
     gpu.OnCommandListEnd();
@@ -66,6 +69,7 @@ bool DmaPusher::Step() {
 
         if (dma_pushbuffer_subindex >= command_list.command_lists.size()) {
             // We've gone through the current list, remove it from the queue
+            gpu.RecycleCommandList(std::move(command_list));
             dma_pushbuffer.pop();
             dma_pushbuffer_subindex = 0;
         }
@@ -79,6 +83,7 @@ bool DmaPusher::Step() {
         gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
                                             command_list_header.size * sizeof(u32));
     }
+    gpu.Capture().OnCommandList(command_headers);
     for (std::size_t index = 0; index < command_headers.size();) {
         const CommandHeader& command_header = command_headers[index];
 
@@ -93,6 +98,17 @@ bool DmaPusher::Step() {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (!dma_increment_once && dma_state.method >= non_puller_methods) {
+                // Hand the whole run of consecutive registers to the engine at once
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, command_headers.size()) -
+                    index);
+                CallMethodRange(&command_header.argument, max_write);
+                dma_state.method += max_write;
+                dma_state.method_count -= max_write;
+                dma_state.is_last_call = true;
+                index += max_write;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -148,7 +164,22 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
     dma_state.method_count = command_header.method_count;
 }
 
+void DmaPusher::WaitPendingCopies() const {
+    Engines::MaxwellDMA& maxwell_dma = gpu.MaxwellDMA();
+    if (!maxwell_dma.HasPendingCopy()) {
+        return;
+    }
+    // Registers of the copy engine itself can be written while the copy is in flight, anything
+    // else may observe its destination
+    const bool is_copy_register = dma_state.method >= non_puller_methods &&
+                                  subchannels[dma_state.subchannel] == &maxwell_dma;
+    if (!is_copy_register) {
+        maxwell_dma.WaitPendingCopy();
+    }
+}
+
 void DmaPusher::CallMethod(u32 argument) const {
+    WaitPendingCopies();
     if (dma_state.method < non_puller_methods) {
         gpu.CallMethod(GPU::MethodCall{
             dma_state.method,
@@ -163,6 +194,7 @@ void DmaPusher::CallMethod(u32 argument) const {
 }
 
 void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    WaitPendingCopies();
     if (dma_state.method < non_puller_methods) {
         gpu.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                             dma_state.method_count);
@@ -172,4 +204,10 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+void DmaPusher::CallMethodRange(const u32* base_start, u32 num_methods) const {
+    WaitPendingCopies();
+    subchannels[dma_state.subchannel]->CallMethodRange(dma_state.method, base_start, num_methods,
+                                                       dma_state.method_count);
+}
+
 } // namespace Tegra
@@ -123,8 +123,12 @@ private:
 
     void SetState(const CommandHeader& command_header);
 
+    /// Waits for an asynchronous copy of the DMA engine before a method that may depend on it
+    void WaitPendingCopies() const;
+
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
+    void CallMethodRange(const u32* base_start, u32 num_methods) const;
 
     std::vector<CommandHeader> command_headers; ///< Buffer for list of commands fetched at once
 
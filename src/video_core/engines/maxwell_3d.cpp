@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
@@ -21,6 +22,44 @@ using VideoCore::QueryType;
 /// First register id that is actually a Macro call.
 constexpr u32 MacroRegistersStart = 0xE00;
 
+/// Returns a table of the registers whose writes do more than update the register file.
+/// Keep in sync with the methods handled by ProcessMethodCall.
+constexpr std::array<bool, Maxwell3D::Regs::NUM_REGS> MakeMethodSideEffectTable() {
+    std::array<bool, Maxwell3D::Regs::NUM_REGS> table{};
+    constexpr std::array methods{
+        MAXWELL3D_REG_INDEX(wait_for_idle),
+        MAXWELL3D_REG_INDEX(shadow_ram_control),
+        MAXWELL3D_REG_INDEX(macros.data),
+        MAXWELL3D_REG_INDEX(macros.bind),
+        MAXWELL3D_REG_INDEX(firmware[4]),
+        MAXWELL3D_REG_INDEX(cb_bind[0]),
+        MAXWELL3D_REG_INDEX(cb_bind[1]),
+        MAXWELL3D_REG_INDEX(cb_bind[2]),
+        MAXWELL3D_REG_INDEX(cb_bind[3]),
+        MAXWELL3D_REG_INDEX(cb_bind[4]),
+        MAXWELL3D_REG_INDEX(draw.vertex_end_gl),
+        MAXWELL3D_REG_INDEX(clear_buffers),
+        MAXWELL3D_REG_INDEX(query.query_get),
+        MAXWELL3D_REG_INDEX(condition.mode),
+        MAXWELL3D_REG_INDEX(counter_reset),
+        MAXWELL3D_REG_INDEX(sync_info),
+        MAXWELL3D_REG_INDEX(exec_upload),
+        MAXWELL3D_REG_INDEX(data_upload),
+        MAXWELL3D_REG_INDEX(fragment_barrier),
+        MAXWELL3D_REG_INDEX(tiled_cache_barrier),
+    };
+    for (const size_t method : methods) {
+        table[method] = true;
+    }
+    for (size_t i = 0; i < Maxwell3D::Regs::NumCBData; ++i) {
+        table[MAXWELL3D_REG_INDEX(const_buffer.cb_data) + i] = true;
+    }
+    return table;
+}
+
+constexpr std::array<bool, Maxwell3D::Regs::NUM_REGS> MethodHasSideEffects =
+    MakeMethodSideEffectTable();
+
 Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
     : system{system_}, memory_manager{memory_manager_}, macro_engine{GetMacroEngine(*this)},
       upload_state{memory_manager, regs.upload} {
@@ -165,6 +204,37 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessRegisterRange(u32 method, const u32* arguments, u32 amount) {
+    if (cb_data_state.current != null_cb_data) {
+        FinishCBData();
+    }
+
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], arguments, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        arguments = &shadow_state.reg_array[method];
+    }
+
+    u32* const registers = &regs.reg_array[method];
+    if (std::memcmp(registers, arguments, amount * sizeof(u32)) == 0) {
+        // Redundant update, nothing becomes dirty
+        return;
+    }
+    DirtyState::Flags changed;
+    for (u32 i = 0; i < amount; ++i) {
+        if (registers[i] == arguments[i]) {
+            continue;
+        }
+        for (const auto& table : dirty.tables) {
+            changed[table[method + i]] = true;
+        }
+    }
+    std::memcpy(registers, arguments, amount * sizeof(u32));
+    dirty.flags |= changed;
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -305,6 +375,16 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         ProcessCBMultiData(method, base_start, amount);
         break;
     default:
+        if (!MethodHasSideEffects[method] && executing_macro == 0) {
+            // Only the register file changes, skip the per method dispatch
+            if (cb_data_state.current != null_cb_data) {
+                FinishCBData();
+            }
+            for (u32 i = 0; i < amount; ++i) {
+                ProcessDirtyRegisters(method, ProcessShadowRam(method, base_start[i]));
+            }
+            break;
+        }
         for (std::size_t i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - static_cast<u32>(i) <= 1);
         }
@@ -312,6 +392,30 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                                u32 methods_pending) {
+    u32 index = 0;
+    while (index < amount) {
+        const u32 first = method + index;
+        if (first >= MacroRegistersStart || MethodHasSideEffects[first] || executing_macro != 0) {
+            CallMethod(first, base_start[index], methods_pending - index <= 1);
+            ++index;
+            continue;
+        }
+        ASSERT_MSG(first < Regs::NUM_REGS,
+                   "Invalid Maxwell3D register, increase the size of the Regs structure");
+
+        // Batch every following register that has no side effects
+        u32 end = index + 1;
+        while (end < amount && method + end < MacroRegistersStart &&
+               !MethodHasSideEffects[method + end]) {
+            ++end;
+        }
+        ProcessRegisterRange(first, base_start + index, end - index);
+        index = end;
+    }
+}
+
 void Maxwell3D::StepInstance(const MMEDrawMode expected_mode, const u32 count) {
     if (mme_draw.current_mode == MMEDrawMode::Undefined) {
         if (mme_draw.gl_begin_consume) {
@@ -612,12 +716,9 @@ void Maxwell3D::ProcessCBMultiData(u32 method, const u32* start_base, u32 amount
         cb_data_state.counter = 0;
     }
     const std::size_t id = cb_data_state.id;
-    const std::size_t size = amount;
-    std::size_t i = 0;
-    for (; i < size; i++) {
-        cb_data_state.buffer[id][cb_data_state.counter] = start_base[i];
-        cb_data_state.counter++;
-    }
+    std::memcpy(&cb_data_state.buffer[id][cb_data_state.counter], start_base,
+                amount * sizeof(u32));
+    cb_data_state.counter += amount;
     // Increment the current buffer position.
     regs.const_buffer.cb_pos = regs.const_buffer.cb_pos + 4 * amount;
 }
@@ -633,8 +734,11 @@ void Maxwell3D::FinishCBData() {
     const GPUVAddr address{buffer_address + cb_data_state.start_pos};
     const std::size_t size = regs.const_buffer.cb_pos - cb_data_state.start_pos;
 
+    // Let the rasterizer hand the data straight to the buffer holding it, so the next draw doesn't
+    // have to upload it again from guest memory
     const u32 id = cb_data_state.id;
-    memory_manager.WriteBlock(address, cb_data_state.buffer[id].data(), size);
+    const u8* const data = reinterpret_cast<const u8*>(cb_data_state.buffer[id].data());
+    rasterizer->AccelerateInlineToMemory(address, size, std::span(data, size));
 
     cb_data_state.id = null_cb_data;
     cb_data_state.current = null_cb_data;
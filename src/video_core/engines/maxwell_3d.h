@@ -1418,6 +1418,10 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write multiple values to consecutive registers, starting at the one identified by method.
+    void CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                         u32 methods_pending) override;
+
     /// Write the value to the register identified by method.
     void CallMethodFromMME(u32 method, u32 method_argument);
 
@@ -1485,6 +1489,9 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Writes a run of registers without side effects, tracking shadow RAM and dirty flags.
+    void ProcessRegisterRange(u32 method, const u32* arguments, u32 amount);
+
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
 
     /// Retrieves information about a specific TIC entry from the TIC buffer.
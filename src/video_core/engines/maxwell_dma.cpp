@@ -2,8 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <thread>
+
 #include "common/assert.h"
+#include "common/div_ceil.h"
 #include "common/logging/log.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/settings.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -16,8 +21,18 @@ namespace Tegra::Engines {
 
 using namespace Texture;
 
+namespace {
+/// Copies with a smaller destination are converted inline on the GPU thread
+constexpr size_t MIN_ASYNC_COPY_SIZE = 256 * 1024;
+/// Minimum number of lines converted by a single worker job
+constexpr u32 MIN_LINES_PER_CHUNK = 16;
+} // Anonymous namespace
+
 MaxwellDMA::MaxwellDMA(Core::System& system_, MemoryManager& memory_manager_)
-    : system{system_}, memory_manager{memory_manager_} {}
+    : system{system_}, memory_manager{memory_manager_} {
+    num_workers = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+    workers = std::make_unique<Common::ThreadWorker>(num_workers, "yuzu:DmaCopy");
+}
 
 MaxwellDMA::~MaxwellDMA() = default;
 
@@ -38,10 +53,57 @@ void MaxwellDMA::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void MaxwellDMA::WaitPendingCopy() {
+    if (!pending_copy) {
+        return;
+    }
+    {
+        std::unique_lock lock{pending_mutex};
+        pending_cv.wait(lock, [this] { return pending_chunks == 0; });
+    }
+    memory_manager.WriteBlock(pending_copy->dst_addr, write_buffer.data(), pending_copy->dst_size);
+    pending_copy.reset();
+}
+
+template <typename Func>
+void MaxwellDMA::ConvertLines(GPUVAddr dst_addr, size_t dst_size, u32 line_count, Func&& func) {
+    if (dst_size < MIN_ASYNC_COPY_SIZE || line_count < MIN_LINES_PER_CHUNK * 2) {
+        func(0, line_count);
+        memory_manager.WriteBlock(dst_addr, write_buffer.data(), dst_size);
+        return;
+    }
+    const u32 max_chunks = std::min(static_cast<u32>(num_workers) * 2,
+                                    line_count / MIN_LINES_PER_CHUNK);
+    const u32 lines_per_chunk = Common::DivCeil(line_count, max_chunks);
+    {
+        std::scoped_lock lock{pending_mutex};
+        pending_chunks = Common::DivCeil(line_count, lines_per_chunk);
+    }
+    // Chunks are made of whole lines, so they never write the same bytes of the destination
+    for (u32 first_line = 0; first_line < line_count; first_line += lines_per_chunk) {
+        const u32 num_lines = std::min(lines_per_chunk, line_count - first_line);
+        workers->QueueWork([this, func, first_line, num_lines] {
+            func(first_line, num_lines);
+
+            std::scoped_lock lock{pending_mutex};
+            if (--pending_chunks == 0) {
+                pending_cv.notify_all();
+            }
+        });
+    }
+    pending_copy = PendingCopy{
+        .dst_addr = dst_addr,
+        .dst_size = dst_size,
+    };
+}
+
 void MaxwellDMA::Launch() {
     LOG_TRACE(Render_OpenGL, "DMA copy 0x{:x} -> 0x{:x}", static_cast<GPUVAddr>(regs.offset_in),
               static_cast<GPUVAddr>(regs.offset_out));
 
+    // The previous copy may still be converting into the scratch buffers
+    WaitPendingCopy();
+
     // TODO(Subv): Perform more research and implement all features of this engine.
     const LaunchDMA& launch = regs.launch_dma;
     ASSERT(launch.remap_enable == 0);
@@ -125,11 +187,18 @@ void MaxwellDMA::CopyBlockLinearToPitch() {
     memory_manager.ReadBlock(regs.offset_in, read_buffer.data(), src_size);
     memory_manager.ReadBlock(regs.offset_out, write_buffer.data(), dst_size);
 
-    UnswizzleSubrect(regs.line_length_in, regs.line_count, regs.pitch_out, width, bytes_per_pixel,
-                     block_height, src_params.origin.x, src_params.origin.y, write_buffer.data(),
-                     read_buffer.data());
-
-    memory_manager.WriteBlock(regs.offset_out, write_buffer.data(), dst_size);
+    // Registers may change before the workers run, capture everything by value
+    const u32 line_length = regs.line_length_in;
+    const u32 pitch = regs.pitch_out;
+    const u32 origin_x = src_params.origin.x;
+    const u32 origin_y = src_params.origin.y;
+    u8* const dst = write_buffer.data();
+    const u8* const src = read_buffer.data();
+    ConvertLines(regs.offset_out, dst_size, regs.line_count, [=](u32 first_line, u32 num_lines) {
+        UnswizzleSubrect(line_length, num_lines, pitch, width, bytes_per_pixel, block_height,
+                         origin_x, origin_y + first_line,
+                         dst + static_cast<size_t>(first_line) * pitch, src);
+    });
 }
 
 void MaxwellDMA::CopyPitchToBlockLinear() {
@@ -170,13 +239,22 @@ void MaxwellDMA::CopyPitchToBlockLinear() {
         SwizzleSliceToVoxel(regs.line_length_in, regs.line_count, regs.pitch_in, width, height,
                             bytes_per_pixel, block_height, block_depth, dst_params.origin.x,
                             dst_params.origin.y, write_buffer.data(), read_buffer.data());
-    } else {
-        SwizzleSubrect(regs.line_length_in, regs.line_count, regs.pitch_in, width, bytes_per_pixel,
-                       write_buffer.data() + dst_layer_size * dst_params.layer, read_buffer.data(),
-                       block_height, dst_params.origin.x, dst_params.origin.y);
+        memory_manager.WriteBlock(regs.offset_out, write_buffer.data(), dst_size);
+        return;
     }
 
-    memory_manager.WriteBlock(regs.offset_out, write_buffer.data(), dst_size);
+    // Registers may change before the workers run, capture everything by value
+    const u32 line_length = regs.line_length_in;
+    const u32 pitch = regs.pitch_in;
+    const u32 origin_x = dst_params.origin.x;
+    const u32 origin_y = dst_params.origin.y;
+    u8* const dst = write_buffer.data() + dst_layer_size * dst_params.layer;
+    const u8* const src = read_buffer.data();
+    ConvertLines(regs.offset_out, dst_size, regs.line_count, [=](u32 first_line, u32 num_lines) {
+        SwizzleSubrect(line_length, num_lines, pitch, width, bytes_per_pixel, dst,
+                       src + static_cast<size_t>(first_line) * pitch, block_height, origin_x,
+                       origin_y + first_line);
+    });
 }
 
 void MaxwellDMA::FastCopyBlockLinearToPitch() {
@@ -5,7 +5,11 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_funcs.h"
@@ -13,6 +17,10 @@
 #include "video_core/engines/engine_interface.h"
 #include "video_core/gpu.h"
 
+namespace Common {
+class ThreadWorker;
+}
+
 namespace Core {
 class System;
 }
@@ -197,7 +205,21 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Returns true when a copy is still being converted by the worker threads.
+    [[nodiscard]] bool HasPendingCopy() const noexcept {
+        return pending_copy.has_value();
+    }
+
+    /// Waits for the pending copy, if any, and writes its result to guest memory.
+    void WaitPendingCopy();
+
 private:
+    /// Destination of a copy whose conversion runs on the worker threads
+    struct PendingCopy {
+        GPUVAddr dst_addr;
+        size_t dst_size;
+    };
+
     /// Performs the copy from the source buffer to the destination buffer as configured in the
     /// registers.
     void Launch();
@@ -210,6 +232,14 @@ private:
 
     void FastCopyBlockLinearToPitch();
 
+    /**
+     * Converts line_count lines by calling func(first_line, num_lines) on chunks of lines, and
+     * writes write_buffer to dst_addr once every chunk is done. Large copies are split across the
+     * worker threads and finished by WaitPendingCopy.
+     */
+    template <typename Func>
+    void ConvertLines(GPUVAddr dst_addr, size_t dst_size, u32 line_count, Func&& func);
+
     Core::System& system;
 
     MemoryManager& memory_manager;
@@ -217,6 +247,15 @@ private:
     std::vector<u8> read_buffer;
     std::vector<u8> write_buffer;
 
+    std::optional<PendingCopy> pending_copy;
+    std::mutex pending_mutex;
+    std::condition_variable pending_cv;
+    u32 pending_chunks{};
+
+    /// Declared after the buffers so the workers are joined before they are released
+    std::unique_ptr<Common::ThreadWorker> workers;
+    size_t num_workers{};
+
     static constexpr std::size_t NUM_REGS = 0x800;
     struct Regs {
         union {
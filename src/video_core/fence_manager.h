@@ -55,11 +55,15 @@ public:
 
     void SignalSemaphore(GPUVAddr addr, u32 value) {
         TryReleasePendingFences();
-        const bool should_flush = ShouldFlush();
-        CommitAsyncFlushes();
+        const u64 fence_value = ++timeline;
+        const bool should_flush = CommitAsyncFlushes(fence_value);
         TFence new_fence = CreateFence(addr, value, !should_flush);
-        fences.push(new_fence);
         QueueFence(new_fence);
+        fences.push(PendingFence{
+            .fence = std::move(new_fence),
+            .value = fence_value,
+            .has_flushes = should_flush,
+        });
         if (should_flush) {
             rasterizer.FlushCommands();
         }
@@ -68,11 +72,15 @@ public:
 
     void SignalSyncPoint(u32 value) {
         TryReleasePendingFences();
-        const bool should_flush = ShouldFlush();
-        CommitAsyncFlushes();
+        const u64 fence_value = ++timeline;
+        const bool should_flush = CommitAsyncFlushes(fence_value);
         TFence new_fence = CreateFence(value, !should_flush);
-        fences.push(new_fence);
         QueueFence(new_fence);
+        fences.push(PendingFence{
+            .fence = std::move(new_fence),
+            .value = fence_value,
+            .has_flushes = should_flush,
+        });
         if (should_flush) {
             rasterizer.FlushCommands();
         }
@@ -81,17 +89,14 @@ public:
 
     void WaitPendingFences() {
         while (!fences.empty()) {
-            TFence& current_fence = fences.front();
-            if (ShouldWait()) {
-                WaitFence(current_fence);
-            }
-            PopAsyncFlushes();
-            if (current_fence->IsSemaphore()) {
-                gpu_memory.template Write<u32>(current_fence->GetAddress(),
-                                               current_fence->GetPayload());
+            PendingFence& current = fences.front();
+            if (current.has_flushes) {
+                WaitFence(current.fence);
+                PopAsyncFlushes(current.value);
             } else {
-                gpu.IncrementSyncPoint(current_fence->GetPayload());
+                RetryDeferredQueryFlushes();
             }
+            ReleaseFence(current.fence);
             PopFence();
         }
     }
@@ -125,55 +130,77 @@ protected:
     TQueryCache& query_cache;
 
 private:
+    struct PendingFence {
+        TFence fence;
+        /// Position of the fence in the timeline, the caches key their downloads with it
+        u64 value;
+        /// True when the caches committed downloads that have to wait for this fence
+        bool has_flushes;
+    };
+
     void TryReleasePendingFences() {
         while (!fences.empty()) {
-            TFence& current_fence = fences.front();
-            if (ShouldWait() && !IsFenceSignaled(current_fence)) {
-                return;
-            }
-            PopAsyncFlushes();
-            if (current_fence->IsSemaphore()) {
-                gpu_memory.template Write<u32>(current_fence->GetAddress(),
-                                               current_fence->GetPayload());
+            PendingFence& current = fences.front();
+            if (current.has_flushes) {
+                if (!IsFenceSignaled(current.fence)) {
+                    return;
+                }
+                PopAsyncFlushes(current.value);
             } else {
-                gpu.IncrementSyncPoint(current_fence->GetPayload());
+                RetryDeferredQueryFlushes();
             }
+            ReleaseFence(current.fence);
             PopFence();
         }
     }
 
-    bool ShouldWait() const {
-        std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-        return texture_cache.ShouldWaitAsyncFlushes() || buffer_cache.ShouldWaitAsyncFlushes() ||
-               query_cache.ShouldWaitAsyncFlushes();
+    void ReleaseFence(TFence& fence) {
+        if (fence->IsSemaphore()) {
+            gpu_memory.template Write<u32>(fence->GetAddress(), fence->GetPayload());
+        } else {
+            gpu.IncrementSyncPoint(fence->GetPayload());
+        }
     }
 
-    bool ShouldFlush() const {
+    /// Commits the pending downloads of every cache to the given fence value.
+    /// Returns true when any cache had downloads to commit.
+    bool CommitAsyncFlushes(u64 fence_value) {
+        // Download lists are only modified from the GPU thread, which is the one signalling
+        // fences, so they can be checked without taking the cache locks
+        if (!texture_cache.HasUncommittedFlushes() && !buffer_cache.HasUncommittedFlushes() &&
+            !query_cache.HasUncommittedFlushes()) {
+            return false;
+        }
         std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-        return texture_cache.HasUncommittedFlushes() || buffer_cache.HasUncommittedFlushes() ||
-               query_cache.HasUncommittedFlushes();
+        texture_cache.CommitAsyncFlushes(fence_value);
+        buffer_cache.CommitAsyncFlushes(fence_value);
+        query_cache.CommitAsyncFlushes(fence_value);
+        return true;
     }
 
-    void PopAsyncFlushes() {
+    void PopAsyncFlushes(u64 fence_value) {
         std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-        texture_cache.PopAsyncFlushes();
-        buffer_cache.PopAsyncFlushes();
-        query_cache.PopAsyncFlushes();
+        texture_cache.PopAsyncFlushes(fence_value);
+        buffer_cache.PopAsyncFlushes(fence_value);
+        query_cache.PopAsyncFlushes(fence_value);
     }
 
-    void CommitAsyncFlushes() {
-        std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-        texture_cache.CommitAsyncFlushes();
-        buffer_cache.CommitAsyncFlushes();
-        query_cache.CommitAsyncFlushes();
+    /// Writes back the queries deferred by previous fences whose results became available.
+    /// Fences without downloads skip PopAsyncFlushes, so these would otherwise stay stale in guest
+    /// memory until a later fence has downloads.
+    void RetryDeferredQueryFlushes() {
+        if (query_cache.HasDeferredFlushes()) {
+            query_cache.RetryDeferredFlushes();
+        }
     }
 
     void PopFence() {
-        delayed_destruction_ring.Push(std::move(fences.front()));
+        delayed_destruction_ring.Push(std::move(fences.front().fence));
         fences.pop();
     }
 
-    std::queue<TFence> fences;
+    std::queue<PendingFence> fences;
+    u64 timeline = 0;
 
     DelayedDestructionRing<TFence, 6> delayed_destruction_ring;
 };
@@ -19,6 +19,7 @@
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/shader_notify.h"
@@ -28,6 +29,9 @@ namespace Tegra {
 
 MICROPROFILE_DEFINE(GPU_wait, "GPU", "Wait for the GPU", MP_RGB(128, 128, 192));
 
+/// Number of processed command lists kept around for reuse
+constexpr std::size_t MAX_POOLED_COMMAND_LISTS = 64;
+
 GPU::GPU(Core::System& system_, bool is_async_, bool use_nvdec_)
     : system{system_}, memory_manager{std::make_unique<Tegra::MemoryManager>(system)},
       dma_pusher{std::make_unique<Tegra::DmaPusher>(system, *this)},
@@ -37,8 +41,11 @@ GPU::GPU(Core::System& system_, bool is_async_, bool use_nvdec_)
       kepler_compute{std::make_unique<Engines::KeplerCompute>(system, *memory_manager)},
       maxwell_dma{std::make_unique<Engines::MaxwellDMA>(system, *memory_manager)},
       kepler_memory{std::make_unique<Engines::KeplerMemory>(system, *memory_manager)},
-      shader_notify{std::make_unique<VideoCore::ShaderNotify>()}, is_async{is_async_},
-      gpu_thread{system_, is_async_} {}
+      shader_notify{std::make_unique<VideoCore::ShaderNotify>()},
+      gpu_capture{std::make_unique<Tegra::GPUCapture>(system, *this)}, is_async{is_async_},
+      gpu_thread{system_, is_async_} {
+    command_list_pool.reserve(MAX_POOLED_COMMAND_LISTS);
+}
 
 GPU::~GPU() = default;
 
@@ -68,6 +75,14 @@ const Engines::KeplerCompute& GPU::KeplerCompute() const {
     return *kepler_compute;
 }
 
+Engines::MaxwellDMA& GPU::MaxwellDMA() {
+    return *maxwell_dma;
+}
+
+const Engines::MaxwellDMA& GPU::MaxwellDMA() const {
+    return *maxwell_dma;
+}
+
 MemoryManager& GPU::MemoryManager() {
     return *memory_manager;
 }
@@ -92,6 +107,14 @@ const Tegra::CDmaPusher& GPU::CDmaPusher() const {
     return *cdma_pusher;
 }
 
+GPUCapture& GPU::Capture() {
+    return *gpu_capture;
+}
+
+const GPUCapture& GPU::Capture() const {
+    return *gpu_capture;
+}
+
 void GPU::WaitFence(u32 syncpoint_id, u32 value) {
     // Synced GPU, is always in sync
     if (!is_async) {
@@ -131,6 +154,12 @@ u32 GPU::GetSyncpointValue(const u32 syncpoint_id) const {
     return syncpoints.at(syncpoint_id).load();
 }
 
+void GPU::SetSyncpointValue(const u32 syncpoint_id, const u32 value) {
+    syncpoints.at(syncpoint_id).store(value);
+    std::lock_guard lock{sync_mutex};
+    sync_cv.notify_all();
+}
+
 void GPU::RegisterSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
     auto& interrupt = syncpt_interrupts.at(syncpoint_id);
     bool contains = std::any_of(interrupt.begin(), interrupt.end(),
@@ -477,6 +506,27 @@ void GPU::PushGPUEntries(Tegra::CommandList&& entries) {
     gpu_thread.SubmitList(std::move(entries));
 }
 
+Tegra::CommandList GPU::AcquireCommandList(std::size_t num_entries) {
+    Tegra::CommandList list;
+    {
+        std::scoped_lock lock{command_list_pool_mutex};
+        if (!command_list_pool.empty()) {
+            list = std::move(command_list_pool.back());
+            command_list_pool.pop_back();
+        }
+    }
+    list.command_lists.resize(num_entries);
+    list.prefetch_command_list.clear();
+    return list;
+}
+
+void GPU::RecycleCommandList(Tegra::CommandList&& list) {
+    std::scoped_lock lock{command_list_pool_mutex};
+    if (command_list_pool.size() < MAX_POOLED_COMMAND_LISTS) {
+        command_list_pool.push_back(std::move(list));
+    }
+}
+
 void GPU::PushCommandBuffer(Tegra::ChCommandHeaderList& entries) {
     if (!use_nvdec) {
         return;
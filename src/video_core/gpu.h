@@ -10,6 +10,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <vector>
 #include "common/common_types.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/nvflinger/buffer_queue.h"
@@ -102,6 +103,7 @@ enum class DepthFormat : u32 {
 
 struct CommandListHeader;
 class DebugContext;
+class GPUCapture;
 
 namespace Engines {
 class Fermi2D;
@@ -181,6 +183,12 @@ public:
     /// Returns a reference to the KeplerCompute GPU engine.
     [[nodiscard]] const Engines::KeplerCompute& KeplerCompute() const;
 
+    /// Returns a reference to the MaxwellDMA GPU engine.
+    [[nodiscard]] Engines::MaxwellDMA& MaxwellDMA();
+
+    /// Returns a const reference to the MaxwellDMA GPU engine.
+    [[nodiscard]] const Engines::MaxwellDMA& MaxwellDMA() const;
+
     /// Returns a reference to the GPU memory manager.
     [[nodiscard]] Tegra::MemoryManager& MemoryManager();
 
@@ -199,6 +207,12 @@ public:
     /// Returns a const reference to the GPU CDMA pusher.
     [[nodiscard]] const Tegra::CDmaPusher& CDmaPusher() const;
 
+    /// Returns a reference to the GPU command stream recorder.
+    [[nodiscard]] Tegra::GPUCapture& Capture();
+
+    /// Returns a const reference to the GPU command stream recorder.
+    [[nodiscard]] const Tegra::GPUCapture& Capture() const;
+
     /// Returns a reference to the underlying renderer.
     [[nodiscard]] VideoCore::RendererBase& Renderer() {
         return *renderer;
@@ -229,6 +243,9 @@ public:
 
     [[nodiscard]] u32 GetSyncpointValue(u32 syncpoint_id) const;
 
+    /// Overwrites the value of a syncpoint, used to restore the state of a GPU capture
+    void SetSyncpointValue(u32 syncpoint_id, u32 value);
+
     void RegisterSyncptInterrupt(u32 syncpoint_id, u32 value);
 
     [[nodiscard]] bool CancelSyncptInterrupt(u32 syncpoint_id, u32 value);
@@ -321,6 +338,12 @@ public:
     /// Push GPU command entries to be processed
     void PushGPUEntries(Tegra::CommandList&& entries);
 
+    /// Returns a command list sized for num_entries entries, reusing the storage of a processed one
+    [[nodiscard]] Tegra::CommandList AcquireCommandList(std::size_t num_entries);
+
+    /// Keeps the storage of a processed command list for later submissions
+    void RecycleCommandList(Tegra::CommandList&& list);
+
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(Tegra::ChCommandHeaderList& entries);
 
@@ -384,6 +407,8 @@ private:
     std::unique_ptr<Engines::KeplerMemory> kepler_memory;
     /// Shader build notifier
     std::unique_ptr<VideoCore::ShaderNotify> shader_notify;
+    /// Command stream recorder
+    std::unique_ptr<Tegra::GPUCapture> gpu_capture;
 
     std::array<std::atomic<u32>, Service::Nvidia::MaxSyncPoints> syncpoints{};
 
@@ -402,6 +427,10 @@ private:
         std::size_t size;
     };
 
+    /// Command lists processed by the DMA pusher, reused by nvdrv submissions
+    std::vector<Tegra::CommandList> command_list_pool;
+    std::mutex command_list_pool_mutex;
+
     std::list<FlushRequest> flush_requests;
     std::atomic<u64> current_flush_fence{};
     u64 last_flush_fence{};
@@ -0,0 +1,482 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "common/alignment.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/core.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra {
+namespace {
+
+constexpr u32 CaptureMagic = 0x50434759; // "YGCP"
+constexpr u32 CaptureVersion = 3;
+
+/// Granularity of the guest memory diffs stored in each frame
+constexpr u64 CapturePageSize = 0x1000;
+
+/// svcSetHeapSize requires sizes aligned to 2MiB
+constexpr u64 HeapSizeAlignment = 0x200000;
+
+struct FileHeader {
+    u32 magic;
+    u32 version;
+    u32 num_frames;
+    u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16, "FileHeader has incorrect size");
+
+template <typename T>
+void Append(std::vector<u8>& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+void AppendArray(std::vector<u8>& out, std::span<const T> values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Append(out, static_cast<u64>(values.size()));
+    const size_t offset = out.size();
+    out.resize(offset + values.size_bytes());
+    if (!values.empty()) {
+        std::memcpy(out.data() + offset, values.data(), values.size_bytes());
+    }
+}
+
+/// Bounds checked reader over a decompressed block
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data_) : data{data_} {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool ReadArray(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        u64 count;
+        if (!Read(count) || count > (data.size() - offset) / sizeof(T)) {
+            return false;
+        }
+        values.resize(count);
+        if (count != 0) {
+            std::memcpy(values.data(), data.data() + offset, count * sizeof(T));
+        }
+        offset += count * sizeof(T);
+        return true;
+    }
+
+    [[nodiscard]] size_t Remaining() const {
+        return data.size() - offset;
+    }
+
+private:
+    std::span<const u8> data;
+    size_t offset{};
+};
+
+void AppendCommandLists(std::vector<u8>& out,
+                        const std::vector<std::vector<CommandHeader>>& command_lists) {
+    Append(out, static_cast<u64>(command_lists.size()));
+    for (const auto& command_list : command_lists) {
+        AppendArray<CommandHeader>(out, command_list);
+    }
+}
+
+bool ReadCommandLists(Reader& reader, std::vector<std::vector<CommandHeader>>& command_lists) {
+    u64 num_command_lists;
+    // Every list stores at least its size
+    if (!reader.Read(num_command_lists) ||
+        num_command_lists > reader.Remaining() / sizeof(u64)) {
+        return false;
+    }
+    command_lists.resize(num_command_lists);
+    for (auto& command_list : command_lists) {
+        if (!reader.ReadArray(command_list)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+struct GPUCapture::Frame {
+    struct MappedRange {
+        GPUVAddr gpu_addr;
+        VAddr cpu_addr;
+        u64 size;
+    };
+
+    struct Page {
+        GPUVAddr gpu_addr;
+        u64 size;
+    };
+
+    /// Syncpoint values when the frame started, command lists acquire fences against them
+    std::array<u32, Service::Nvidia::MaxSyncPoints> syncpoints{};
+    std::vector<MappedRange> ranges;
+    std::vector<Page> pages;
+    std::vector<u8> page_data;
+    std::vector<std::vector<CommandHeader>> command_lists;
+    std::optional<FramebufferConfig> framebuffer;
+
+    [[nodiscard]] std::vector<u8> Serialize() const {
+        std::vector<u8> out;
+        Append(out, syncpoints);
+        AppendArray<MappedRange>(out, ranges);
+        AppendArray<Page>(out, pages);
+        AppendArray<u8>(out, page_data);
+        AppendCommandLists(out, command_lists);
+        Append(out, static_cast<u8>(framebuffer.has_value()));
+        Append(out, framebuffer.value_or(FramebufferConfig{}));
+        return out;
+    }
+
+    bool Deserialize(std::span<const u8> data) {
+        Reader reader{data};
+        if (!reader.Read(syncpoints) || !reader.ReadArray(ranges) || !reader.ReadArray(pages) ||
+            !reader.ReadArray(page_data) || !ReadCommandLists(reader, command_lists)) {
+            return false;
+        }
+        u8 has_framebuffer;
+        FramebufferConfig framebuffer_config;
+        if (!reader.Read(has_framebuffer) || !reader.Read(framebuffer_config)) {
+            return false;
+        }
+        if (has_framebuffer != 0) {
+            framebuffer = framebuffer_config;
+        }
+        u64 total_page_size = 0;
+        for (const Page& page : pages) {
+            total_page_size += page.size;
+        }
+        return total_page_size == page_data.size();
+    }
+};
+
+GPUCapture::GPUCapture(Core::System& system_, GPU& gpu_) : system{system_}, gpu{gpu_} {}
+
+GPUCapture::~GPUCapture() = default;
+
+void GPUCapture::BeginRecording(std::string path_, u32 num_frames_) {
+    if (state.load(std::memory_order_acquire) != State::Idle) {
+        LOG_WARNING(HW_GPU, "A GPU capture is already in progress");
+        return;
+    }
+    if (has_processed_commands.load(std::memory_order_relaxed)) {
+        // The state set up by the lists already executed could not be reproduced on replay
+        LOG_ERROR(HW_GPU, "GPU captures must be requested before the GPU processes commands");
+        return;
+    }
+    path = std::move(path_);
+    num_frames = std::max(num_frames_, 1U);
+    // Recording starts at the next frame boundary so the first frame is complete
+    state.store(State::Armed, std::memory_order_release);
+}
+
+void GPUCapture::RecordCommandList(std::span<const CommandHeader> commands) {
+    auto& command_lists = state.load(std::memory_order_relaxed) == State::Armed
+                              ? setup_command_lists
+                              : frames.back().command_lists;
+    command_lists.emplace_back(commands.begin(), commands.end());
+}
+
+void GPUCapture::OnSwapBuffers(const FramebufferConfig* framebuffer) {
+    switch (state.load(std::memory_order_acquire)) {
+    case State::Idle:
+        return;
+    case State::Armed:
+        LOG_INFO(HW_GPU, "Recording {} frames into {}", num_frames, path);
+        BeginFrame();
+        state.store(State::Recording, std::memory_order_relaxed);
+        return;
+    case State::Recording:
+        if (framebuffer) {
+            frames.back().framebuffer = *framebuffer;
+        }
+        if (frames.size() < num_frames) {
+            BeginFrame();
+            return;
+        }
+        state.store(State::Idle, std::memory_order_relaxed);
+        Save();
+        setup_command_lists.clear();
+        frames.clear();
+        shadow_memory.clear();
+        scratch = {};
+        return;
+    }
+}
+
+void GPUCapture::BeginFrame() {
+    Frame& frame = frames.emplace_back();
+    auto& memory_manager = gpu.MemoryManager();
+
+    for (u32 id = 0; id < frame.syncpoints.size(); ++id) {
+        frame.syncpoints[id] = gpu.GetSyncpointValue(id);
+    }
+
+    std::unordered_map<GPUVAddr, std::vector<u8>> next_shadow_memory;
+    for (const auto& [gpu_addr, size] : memory_manager.GetMappedRanges()) {
+        const std::optional<VAddr> cpu_addr = memory_manager.GpuToCpuAddress(gpu_addr);
+        if (!cpu_addr || size == 0) {
+            continue;
+        }
+        frame.ranges.push_back({gpu_addr, *cpu_addr, size});
+
+        scratch.resize(size);
+        memory_manager.ReadBlockUnsafe(gpu_addr, scratch.data(), size);
+
+        // Ranges that were not mapped in the previous frame are stored in full
+        const auto it = shadow_memory.find(gpu_addr);
+        const bool is_new = it == shadow_memory.end() || it->second.size() != size;
+        for (u64 offset = 0; offset < size; offset += CapturePageSize) {
+            const u64 page_size = std::min(CapturePageSize, size - offset);
+            const u8* const page = scratch.data() + offset;
+            if (!is_new && std::memcmp(it->second.data() + offset, page, page_size) == 0) {
+                continue;
+            }
+            frame.pages.push_back({gpu_addr + offset, page_size});
+            frame.page_data.insert(frame.page_data.end(), page, page + page_size);
+        }
+        if (is_new) {
+            next_shadow_memory.emplace(gpu_addr, std::move(scratch));
+            scratch = {};
+        } else {
+            std::swap(it->second, scratch);
+            next_shadow_memory.emplace(gpu_addr, std::move(it->second));
+        }
+    }
+    shadow_memory = std::move(next_shadow_memory);
+}
+
+void GPUCapture::Save() const {
+    Common::FS::IOFile file(path, "wb");
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to create GPU capture file {}", path);
+        return;
+    }
+    const FileHeader header{
+        .magic = CaptureMagic,
+        .version = CaptureVersion,
+        .num_frames = static_cast<u32>(frames.size()),
+        .reserved = 0,
+    };
+    if (file.WriteObject(header) != 1) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU capture file {}", path);
+        return;
+    }
+    u64 total_size = sizeof(header);
+    const auto write_block = [&](const std::vector<u8>& serialized) {
+        const std::vector<u8> compressed =
+            Common::Compression::CompressDataZSTDDefault(serialized.data(), serialized.size());
+        if (file.WriteObject(static_cast<u64>(compressed.size())) != 1 ||
+            file.WriteArray(compressed.data(), compressed.size()) != compressed.size()) {
+            LOG_ERROR(HW_GPU, "Failed to write GPU capture file {}", path);
+            return false;
+        }
+        total_size += sizeof(u64) + compressed.size();
+        return true;
+    };
+
+    // Setup command lists come first, followed by one block per frame
+    std::vector<u8> setup;
+    AppendCommandLists(setup, setup_command_lists);
+    if (!write_block(setup)) {
+        return;
+    }
+    for (const Frame& frame : frames) {
+        if (!write_block(frame.Serialize())) {
+            return;
+        }
+    }
+    LOG_INFO(HW_GPU, "Saved {} frames and {} setup command lists into {} ({} bytes)",
+             frames.size(), setup_command_lists.size(), path, total_size);
+}
+
+bool GPUCapture::RestoreMemory(const Frame& frame) {
+    auto& memory_manager = gpu.MemoryManager();
+    auto& page_table = system.CurrentProcess()->PageTable();
+    auto& memory = system.Memory();
+
+    for (const Frame::MappedRange& range : frame.ranges) {
+        if (memory_manager.GpuToCpuAddress(range.gpu_addr) == range.cpu_addr) {
+            continue;
+        }
+        // The guest has not run, back the range the same way the title did when it was recorded
+        const VAddr begin = Common::AlignDown(range.cpu_addr, Core::Memory::PAGE_SIZE);
+        const VAddr end = Common::AlignUp(range.cpu_addr + range.size, Core::Memory::PAGE_SIZE);
+        bool is_backed = true;
+        for (VAddr addr = begin; addr < end; addr += Core::Memory::PAGE_SIZE) {
+            is_backed &= memory.IsValidVirtualAddress(addr);
+        }
+        if (!is_backed && begin >= page_table.GetHeapRegionStart() &&
+            end <= page_table.GetHeapRegionEnd()) {
+            const u64 heap_size =
+                Common::AlignUp(end - page_table.GetHeapRegionStart(), HeapSizeAlignment);
+            is_backed = heap_size <= page_table.GetHeapSize() ||
+                        page_table.SetHeapSize(heap_size).Succeeded();
+        } else if (!is_backed && begin >= page_table.GetAliasRegionStart() &&
+                   end <= page_table.GetAliasRegionEnd()) {
+            is_backed = page_table.MapPhysicalMemory(begin, end - begin).IsSuccess();
+        }
+        if (!is_backed) {
+            LOG_ERROR(HW_GPU, "Failed to back guest memory at 0x{:x} (0x{:x} bytes)",
+                      range.cpu_addr, range.size);
+            return false;
+        }
+        if (memory_manager.Map(range.cpu_addr, range.gpu_addr, range.size) != range.gpu_addr ||
+            memory_manager.GpuToCpuAddress(range.gpu_addr) != range.cpu_addr) {
+            LOG_ERROR(HW_GPU, "Failed to map GPU address 0x{:x} (0x{:x} bytes)", range.gpu_addr,
+                      range.size);
+            return false;
+        }
+    }
+
+    const u8* page_data = frame.page_data.data();
+    for (const Frame::Page& page : frame.pages) {
+        const std::optional<VAddr> cpu_addr = memory_manager.GpuToCpuAddress(page.gpu_addr);
+        if (cpu_addr) {
+            // Write through the CPU path so the caches are invalidated like a guest write would
+            memory.WriteBlock(*cpu_addr, page_data, page.size);
+        }
+        page_data += page.size;
+    }
+    return true;
+}
+
+std::vector<std::chrono::nanoseconds> GPUCapture::Replay(const std::string& replay_path,
+                                                         u32 num_replay_frames) {
+    Common::FS::IOFile file(replay_path, "rb");
+    FileHeader header{};
+    if (!file.IsOpen() || file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != CaptureMagic || header.version != CaptureVersion ||
+        header.num_frames == 0) {
+        LOG_ERROR(HW_GPU, "Invalid GPU capture file {}", replay_path);
+        return {};
+    }
+    // Every block stores at least its size, the setup block included
+    if (header.num_frames >= file.GetSize() / sizeof(u64)) {
+        LOG_ERROR(HW_GPU, "Truncated GPU capture file {}", replay_path);
+        return {};
+    }
+    const auto read_block = [&](std::vector<u8>& decompressed) {
+        u64 compressed_size;
+        if (file.ReadBytes(&compressed_size, sizeof(compressed_size)) != sizeof(compressed_size) ||
+            compressed_size > file.GetSize()) {
+            LOG_ERROR(HW_GPU, "Truncated GPU capture file {}", replay_path);
+            return false;
+        }
+        std::vector<u8> compressed(compressed_size);
+        if (file.ReadArray(compressed.data(), compressed.size()) != compressed.size()) {
+            LOG_ERROR(HW_GPU, "Truncated GPU capture file {}", replay_path);
+            return false;
+        }
+        decompressed = Common::Compression::DecompressDataZSTD(compressed);
+        return true;
+    };
+
+    std::vector<u8> block;
+    std::vector<std::vector<CommandHeader>> captured_setup_lists;
+    if (!read_block(block)) {
+        return {};
+    }
+    Reader setup_reader{block};
+    if (!ReadCommandLists(setup_reader, captured_setup_lists)) {
+        LOG_ERROR(HW_GPU, "Corrupted GPU capture file {}", replay_path);
+        return {};
+    }
+    std::vector<Frame> captured_frames(header.num_frames);
+    for (Frame& frame : captured_frames) {
+        if (!read_block(block)) {
+            return {};
+        }
+        if (!frame.Deserialize(block)) {
+            LOG_ERROR(HW_GPU, "Corrupted GPU capture file {}", replay_path);
+            return {};
+        }
+    }
+
+    // Rebuild the engine bindings, macros and registers the title set up before the capture. This
+    // runs against the memory of the first frame, which is restored again before it is timed.
+    const Frame& first_frame = captured_frames.front();
+    if (!RestoreMemory(first_frame)) {
+        return {};
+    }
+    gpu.WaitIdle();
+    for (u32 id = 0; id < first_frame.syncpoints.size(); ++id) {
+        gpu.SetSyncpointValue(id, first_frame.syncpoints[id]);
+    }
+    for (const auto& command_list : captured_setup_lists) {
+        gpu.PushGPUEntries(CommandList{std::vector<CommandHeader>(command_list)});
+    }
+    gpu.WaitIdle();
+
+    std::vector<std::chrono::nanoseconds> frame_times;
+    frame_times.reserve(num_replay_frames);
+    for (u32 index = 0; index < num_replay_frames; ++index) {
+        const Frame& frame = captured_frames[index % captured_frames.size()];
+        // Restoring guest memory is not part of the measured work
+        if (!RestoreMemory(frame)) {
+            return {};
+        }
+        gpu.WaitIdle();
+        // Fence acquires in the command lists wait on the values the syncpoints had when the
+        // frame was recorded, replaying on a fresh GPU would block on them forever
+        for (u32 id = 0; id < frame.syncpoints.size(); ++id) {
+            gpu.SetSyncpointValue(id, frame.syncpoints[id]);
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+        for (const auto& command_list : frame.command_lists) {
+            gpu.PushGPUEntries(CommandList{std::vector<CommandHeader>(command_list)});
+        }
+        gpu.SwapBuffers(frame.framebuffer ? &*frame.framebuffer : nullptr);
+        gpu.WaitIdle();
+        frame_times.push_back(std::chrono::steady_clock::now() - start_time);
+    }
+
+    if (!frame_times.empty()) {
+        const auto [min_time, max_time] = std::ranges::minmax(frame_times);
+        std::chrono::nanoseconds total_time{};
+        for (const auto frame_time : frame_times) {
+            total_time += frame_time;
+        }
+        const auto average_time =
+            total_time / static_cast<std::chrono::nanoseconds::rep>(frame_times.size());
+        LOG_INFO(HW_GPU, "Replayed {} frames: average={}us min={}us max={}us",
+                 frame_times.size(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(average_time).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(min_time).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(max_time).count());
+    }
+    return frame_times;
+}
+
+} // namespace Tegra
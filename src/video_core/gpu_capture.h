@@ -0,0 +1,109 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/dma_pusher.h"
+
+namespace Core {
+class System;
+}
+
+namespace Tegra {
+
+class GPU;
+struct FramebufferConfig;
+
+/**
+ * Records the command lists consumed by the DMA pusher over a number of frames, together with the
+ * guest memory mapped in the GPU address space, and feeds them back into the GPU. A capture is a
+ * reproducible workload to benchmark command processing and caches, or to compare backends frame
+ * by frame.
+ *
+ * Command lists are recorded from the moment the capture is requested, which must happen before
+ * the GPU processes its first command list. Lists executed before the first recorded frame are
+ * kept as setup lists: they bind engines, upload macros and program registers the recorded frames
+ * depend on. Replay executes them once, untimed, before the first frame.
+ *
+ * Each frame stores the guest pages that changed since the previous frame started, the first one
+ * holds a full copy of every mapped range. Replaying a frame restores its pages and syncpoint
+ * values before executing its command lists, so frames observe the same memory and fences they did
+ * when they were recorded.
+ */
+class GPUCapture final {
+public:
+    explicit GPUCapture(Core::System& system_, GPU& gpu_);
+    ~GPUCapture();
+
+    /// Records the next num_frames presented frames into the file at path. Must be called before
+    /// the GPU processes its first command list.
+    void BeginRecording(std::string path, u32 num_frames);
+
+    /// Records a command list fetched by the DMA pusher when a capture is in progress. Called from
+    /// the GPU thread.
+    void OnCommandList(std::span<const CommandHeader> commands) {
+        if (state.load(std::memory_order_relaxed) != State::Idle) {
+            RecordCommandList(commands);
+        } else if (!has_processed_commands.load(std::memory_order_relaxed)) {
+            has_processed_commands.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /// Marks the end of a frame. Called from the GPU thread before the frame is presented.
+    void OnSwapBuffers(const FramebufferConfig* framebuffer);
+
+    /**
+     * Replays num_frames frames from the capture at path, wrapping around when the capture is
+     * shorter. The guest must not be running.
+     *
+     * @returns Time spent executing each frame, or an empty vector if the capture failed to load.
+     */
+    std::vector<std::chrono::nanoseconds> Replay(const std::string& path, u32 num_frames);
+
+private:
+    enum class State : u32 {
+        Idle,
+        Armed,
+        Recording,
+    };
+
+    struct Frame;
+
+    void RecordCommandList(std::span<const CommandHeader> commands);
+
+    /// Starts a new frame and stores the guest memory that changed since the previous one.
+    void BeginFrame();
+
+    /// Writes the recorded frames to disk.
+    void Save() const;
+
+    /// Maps the ranges of a frame and restores its guest memory.
+    bool RestoreMemory(const Frame& frame);
+
+    Core::System& system;
+    GPU& gpu;
+
+    std::atomic<State> state{State::Idle};
+    std::atomic<bool> has_processed_commands{};
+    std::string path;
+    u32 num_frames{};
+
+    /// Command lists executed before the first recorded frame
+    std::vector<std::vector<CommandHeader>> setup_command_lists;
+    std::vector<Frame> frames;
+
+    /// Last recorded contents of each mapped range, keyed by GPU address
+    std::unordered_map<GPUVAddr, std::vector<u8>> shadow_memory;
+    std::vector<u8> scratch;
+};
+
+} // namespace Tegra
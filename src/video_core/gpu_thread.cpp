@@ -11,6 +11,7 @@
 #include "core/settings.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/gpu_thread.h"
 #include "video_core/renderer_base.h"
 
@@ -51,7 +52,10 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
             cdma_pusher.Push(std::move(command_list->entries));
             cdma_pusher.DispatchCalls();
         } else if (const auto* data = std::get_if<SwapBuffersCommand>(&next.data)) {
-            renderer.SwapBuffers(data->framebuffer ? &*data->framebuffer : nullptr);
+            const Tegra::FramebufferConfig* framebuffer =
+                data->framebuffer ? &*data->framebuffer : nullptr;
+            system.GPU().Capture().OnSwapBuffers(framebuffer);
+            renderer.SwapBuffers(framebuffer);
         } else if (std::holds_alternative<OnCommandListEndCommand>(next.data)) {
             rasterizer->ReleaseFences();
         } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
@@ -17,7 +17,9 @@
 namespace Tegra {
 
 MemoryManager::MemoryManager(Core::System& system_)
-    : system{system_}, page_table(page_table_size) {}
+    : system{system_}, big_page_table(big_page_table_size),
+      small_page_tables(big_page_table_size), small_page_table_storage(big_page_table_size),
+      free_ranges{{0, address_space_size}} {}
 
 MemoryManager::~MemoryManager() = default;
 
@@ -26,18 +28,94 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
 }
 
 GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
-    u64 remaining_size{size};
-    for (u64 offset{}; offset < size; offset += page_size) {
-        if (remaining_size < page_size) {
-            SetPageEntry(gpu_addr + offset, page_entry + offset, remaining_size);
+    // TODO(bunnei): We should lock/unlock device regions. This currently causes issues due to
+    // improper tracking, but should be fixed in the future.
+
+    const GPUVAddr end = Common::AlignUp(gpu_addr + size, page_size);
+    for (GPUVAddr addr = gpu_addr; addr < end;) {
+        const std::size_t index = BigPageIndex(addr);
+        const GPUVAddr big_page_end = (addr | big_page_mask) + 1;
+        const GPUVAddr run_end = std::min(big_page_end, end);
+        const PageEntry entry = page_entry + (addr - gpu_addr);
+        if ((addr & big_page_mask) == 0 && run_end == big_page_end) {
+            // The whole big page is covered by a contiguous run, a single entry describes it
+            big_page_table[index] = entry;
+            small_page_tables[index].store(nullptr, std::memory_order_release);
         } else {
-            SetPageEntry(gpu_addr + offset, page_entry + offset);
+            SmallPageTable& small_page_table = GetSmallPageTable(index);
+            for (GPUVAddr page = addr; page < run_end; page += page_size) {
+                small_page_table[SmallPageIndex(page)] = entry + (page - addr);
+            }
         }
-        remaining_size -= page_size;
+        addr = run_end;
+    }
+    if (page_entry.IsUnmapped()) {
+        InsertFreeRange(gpu_addr, end);
+    } else {
+        EraseFreeRange(gpu_addr, end);
     }
     return gpu_addr;
 }
 
+MemoryManager::SmallPageTable& MemoryManager::GetSmallPageTable(std::size_t big_page_index) {
+    // Tables are only published from this thread
+    if (SmallPageTable* const table =
+            small_page_tables[big_page_index].load(std::memory_order_relaxed)) {
+        return *table;
+    }
+    std::unique_ptr<SmallPageTable>& small_page_table = small_page_table_storage[big_page_index];
+    if (!small_page_table) {
+        small_page_table = std::make_unique<SmallPageTable>();
+    }
+    const PageEntry big_page_entry = big_page_table[big_page_index];
+    for (std::size_t page = 0; page < pages_per_big_page; ++page) {
+        (*small_page_table)[page] = big_page_entry + page * page_size;
+    }
+    // Only published once filled, so readers never observe a partially initialized table
+    small_page_tables[big_page_index].store(small_page_table.get(), std::memory_order_release);
+    return *small_page_table;
+}
+
+void MemoryManager::InsertFreeRange(GPUVAddr begin, GPUVAddr end) {
+    EraseFreeRange(begin, end);
+    auto next = free_ranges.lower_bound(begin);
+    if (next != free_ranges.end() && next->first == end) {
+        end += next->second;
+        next = free_ranges.erase(next);
+    }
+    if (next != free_ranges.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == begin) {
+            prev->second = end - prev->first;
+            return;
+        }
+    }
+    free_ranges.emplace_hint(next, begin, end - begin);
+}
+
+void MemoryManager::EraseFreeRange(GPUVAddr begin, GPUVAddr end) {
+    auto it = free_ranges.upper_bound(begin);
+    if (it != free_ranges.begin()) {
+        --it;
+    }
+    while (it != free_ranges.end() && it->first < end) {
+        const GPUVAddr range_begin = it->first;
+        const GPUVAddr range_end = range_begin + it->second;
+        if (range_end <= begin) {
+            ++it;
+            continue;
+        }
+        it = free_ranges.erase(it);
+        if (range_begin < begin) {
+            free_ranges.emplace(range_begin, begin - range_begin);
+        }
+        if (range_end > end) {
+            free_ranges.emplace(end, range_end - end);
+            break;
+        }
+    }
+}
+
 GPUVAddr MemoryManager::Map(VAddr cpu_addr, GPUVAddr gpu_addr, std::size_t size) {
     const auto it = std::ranges::lower_bound(map_ranges, gpu_addr, {}, &MapRange::first);
     if (it != map_ranges.end() && it->first == gpu_addr) {
@@ -133,21 +211,58 @@ void MemoryManager::InvalidateQueuedCaches() {
     }
     cache_invalidate_queue.clear();
 }
+
 PageEntry MemoryManager::GetPageEntry(GPUVAddr gpu_addr) const {
-    return page_table[PageEntryIndex(gpu_addr)];
+    const std::size_t index = BigPageIndex(gpu_addr);
+    const SmallPageTable* const table = small_page_tables[index].load(std::memory_order_acquire);
+    if (table) {
+        return (*table)[SmallPageIndex(gpu_addr)];
+    }
+    return big_page_table[index] + (gpu_addr & big_page_mask & ~page_mask);
 }
 
-void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
-    // TODO(bunnei): We should lock/unlock device regions. This currently causes issues due to
-    // improper tracking, but should be fixed in the future.
-
-    //// Unlock the old page
-    // TryUnlockPage(page_table[PageEntryIndex(gpu_addr)], size);
-
-    //// Lock the new page
-    // TryLockPage(page_entry, size);
+std::pair<std::optional<VAddr>, u64> MemoryManager::TranslateEntry(GPUVAddr gpu_addr) const {
+    const std::size_t index = BigPageIndex(gpu_addr);
+    const SmallPageTable* const table = small_page_tables[index].load(std::memory_order_acquire);
+    if (table) {
+        const PageEntry page_entry = (*table)[SmallPageIndex(gpu_addr)];
+        const u64 bytes_to_end = page_size - (gpu_addr & page_mask);
+        if (!page_entry.IsValid()) {
+            return {std::nullopt, bytes_to_end};
+        }
+        return {page_entry.ToAddress() + (gpu_addr & page_mask), bytes_to_end};
+    }
+    const PageEntry page_entry = big_page_table[index];
+    const u64 bytes_to_end = big_page_size - (gpu_addr & big_page_mask);
+    if (!page_entry.IsValid()) {
+        return {std::nullopt, bytes_to_end};
+    }
+    return {page_entry.ToAddress() + (gpu_addr & big_page_mask), bytes_to_end};
+}
 
-    page_table[PageEntryIndex(gpu_addr)] = page_entry;
+template <typename Func>
+void MemoryManager::ForEachContiguousRun(GPUVAddr gpu_addr, std::size_t size, Func&& func) const {
+    std::optional<VAddr> run_cpu_addr;
+    std::size_t run_offset{};
+    std::size_t run_size{};
+    for (std::size_t offset{}; offset < size;) {
+        const auto [cpu_addr, bytes_to_end] = TranslateEntry(gpu_addr + offset);
+        const std::size_t amount{std::min<std::size_t>(bytes_to_end, size - offset)};
+        const bool continues_run = run_cpu_addr ? cpu_addr == *run_cpu_addr + run_size : !cpu_addr;
+        if (run_size == 0 || !continues_run) {
+            if (run_size != 0) {
+                func(run_cpu_addr, run_offset, run_size);
+            }
+            run_cpu_addr = cpu_addr;
+            run_offset = offset;
+            run_size = 0;
+        }
+        run_size += amount;
+        offset += amount;
+    }
+    if (run_size != 0) {
+        func(run_cpu_addr, run_offset, run_size);
+    }
 }
 
 std::optional<GPUVAddr> MemoryManager::FindFreeRange(std::size_t size, std::size_t align,
@@ -157,37 +272,23 @@ std::optional<GPUVAddr> MemoryManager::FindFreeRange(std::size_t size, std::size
     } else {
         align = Common::AlignUp(align, page_size);
     }
-
-    u64 available_size{};
-    GPUVAddr gpu_addr{start_32bit_address ? address_space_start_low : address_space_start};
-    while (gpu_addr + available_size < address_space_size) {
-        if (GetPageEntry(gpu_addr + available_size).IsUnmapped()) {
-            available_size += page_size;
-
-            if (available_size >= size) {
-                return gpu_addr;
-            }
-        } else {
-            gpu_addr += available_size + page_size;
-            available_size = 0;
-
-            const auto remainder{gpu_addr % align};
-            if (remainder) {
-                gpu_addr = (gpu_addr - remainder) + align;
-            }
+    const GPUVAddr min_addr{start_32bit_address ? address_space_start_low : address_space_start};
+    auto it = free_ranges.upper_bound(min_addr);
+    if (it != free_ranges.begin()) {
+        --it;
+    }
+    for (; it != free_ranges.end(); ++it) {
+        const GPUVAddr range_end = it->first + it->second;
+        const GPUVAddr gpu_addr = Common::AlignUp(std::max(it->first, min_addr), align);
+        if (gpu_addr + size <= range_end) {
+            return gpu_addr;
         }
     }
-
     return std::nullopt;
 }
 
 std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
-    const auto page_entry{GetPageEntry(gpu_addr)};
-    if (!page_entry.IsValid()) {
-        return std::nullopt;
-    }
-
-    return page_entry.ToAddress() + (gpu_addr & page_mask);
+    return TranslateEntry(gpu_addr).first;
 }
 
 template <typename T>
@@ -225,10 +326,6 @@ template void MemoryManager::Write<u32>(GPUVAddr addr, u32 data);
 template void MemoryManager::Write<u64>(GPUVAddr addr, u64 data);
 
 u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) {
-    if (!GetPageEntry(gpu_addr).IsValid()) {
-        return {};
-    }
-
     const auto address{GpuToCpuAddress(gpu_addr)};
     if (!address) {
         return {};
@@ -238,10 +335,6 @@ u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) {
 }
 
 const u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) const {
-    if (!GetPageEntry(gpu_addr).IsValid()) {
-        return {};
-    }
-
     const auto address{GpuToCpuAddress(gpu_addr)};
     if (!address) {
         return {};
@@ -257,114 +350,64 @@ size_t MemoryManager::BytesToMapEnd(GPUVAddr gpu_addr) const noexcept {
 }
 
 void MemoryManager::ReadBlock(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size) const {
-    std::size_t remaining_size{size};
-    std::size_t page_index{gpu_src_addr >> page_bits};
-    std::size_t page_offset{gpu_src_addr & page_mask};
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount{
-            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            const auto src_addr{*page_addr + page_offset};
-
-            // Flush must happen on the rasterizer interface, such that memory is always synchronous
-            // when it is read (even when in asynchronous GPU mode). Fixes Dead Cells title menu.
-            rasterizer->FlushRegion(src_addr, copy_amount);
-            system.Memory().ReadBlockUnsafe(src_addr, dest_buffer, copy_amount);
+    u8* const dest = static_cast<u8*>(dest_buffer);
+    const auto read = [&](std::optional<VAddr> src_addr, std::size_t offset, std::size_t amount) {
+        if (!src_addr) {
+            return;
         }
-
-        page_index++;
-        page_offset = 0;
-        dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
-        remaining_size -= copy_amount;
-    }
+        // Flush must happen on the rasterizer interface, such that memory is always synchronous
+        // when it is read (even when in asynchronous GPU mode). Fixes Dead Cells title menu.
+        rasterizer->FlushRegion(*src_addr, amount);
+        system.Memory().ReadBlockUnsafe(*src_addr, dest + offset, amount);
+    };
+    ForEachContiguousRun(gpu_src_addr, size, read);
 }
 
 void MemoryManager::ReadBlockUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
                                     const std::size_t size) const {
-    std::size_t remaining_size{size};
-    std::size_t page_index{gpu_src_addr >> page_bits};
-    std::size_t page_offset{gpu_src_addr & page_mask};
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount{
-            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            const auto src_addr{*page_addr + page_offset};
-            system.Memory().ReadBlockUnsafe(src_addr, dest_buffer, copy_amount);
+    u8* const dest = static_cast<u8*>(dest_buffer);
+    const auto read = [&](std::optional<VAddr> src_addr, std::size_t offset, std::size_t amount) {
+        if (src_addr) {
+            system.Memory().ReadBlockUnsafe(*src_addr, dest + offset, amount);
         } else {
-            std::memset(dest_buffer, 0, copy_amount);
+            std::memset(dest + offset, 0, amount);
         }
-
-        page_index++;
-        page_offset = 0;
-        dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
-        remaining_size -= copy_amount;
-    }
+    };
+    ForEachContiguousRun(gpu_src_addr, size, read);
 }
 
 void MemoryManager::WriteBlock(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size) {
-    std::size_t remaining_size{size};
-    std::size_t page_index{gpu_dest_addr >> page_bits};
-    std::size_t page_offset{gpu_dest_addr & page_mask};
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount{
-            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            const auto dest_addr{*page_addr + page_offset};
-
-            // Invalidate must happen on the rasterizer interface, such that memory is always
-            // synchronous when it is written (even when in asynchronous GPU mode).
-            rasterizer->InvalidateRegion(dest_addr, copy_amount);
-            system.Memory().WriteBlockUnsafe(dest_addr, src_buffer, copy_amount);
+    const u8* const src = static_cast<const u8*>(src_buffer);
+    const auto write = [&](std::optional<VAddr> dest_addr, std::size_t offset, std::size_t amount) {
+        if (!dest_addr) {
+            return;
         }
-
-        page_index++;
-        page_offset = 0;
-        src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
-        remaining_size -= copy_amount;
-    }
+        // Invalidate must happen on the rasterizer interface, such that memory is always
+        // synchronous when it is written (even when in asynchronous GPU mode).
+        rasterizer->InvalidateRegion(*dest_addr, amount);
+        system.Memory().WriteBlockUnsafe(*dest_addr, src + offset, amount);
+    };
+    ForEachContiguousRun(gpu_dest_addr, size, write);
 }
 
 void MemoryManager::WriteBlockUnsafe(GPUVAddr gpu_dest_addr, const void* src_buffer,
                                      std::size_t size) {
-    std::size_t remaining_size{size};
-    std::size_t page_index{gpu_dest_addr >> page_bits};
-    std::size_t page_offset{gpu_dest_addr & page_mask};
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount{
-            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            const auto dest_addr{*page_addr + page_offset};
-            system.Memory().WriteBlockUnsafe(dest_addr, src_buffer, copy_amount);
+    const u8* const src = static_cast<const u8*>(src_buffer);
+    const auto write = [&](std::optional<VAddr> dest_addr, std::size_t offset, std::size_t amount) {
+        if (dest_addr) {
+            system.Memory().WriteBlockUnsafe(*dest_addr, src + offset, amount);
         }
-
-        page_index++;
-        page_offset = 0;
-        src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
-        remaining_size -= copy_amount;
-    }
+    };
+    ForEachContiguousRun(gpu_dest_addr, size, write);
 }
 
 void MemoryManager::FlushRegion(GPUVAddr gpu_addr, size_t size) const {
-    size_t remaining_size{size};
-    size_t page_index{gpu_addr >> page_bits};
-    size_t page_offset{gpu_addr & page_mask};
-    while (remaining_size > 0) {
-        const size_t num_bytes{std::min(page_size - page_offset, remaining_size)};
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            rasterizer->FlushRegion(*page_addr + page_offset, num_bytes);
+    const auto flush = [this](std::optional<VAddr> cpu_addr, std::size_t, std::size_t amount) {
+        if (cpu_addr) {
+            rasterizer->FlushRegion(*cpu_addr, amount);
         }
-        ++page_index;
-        page_offset = 0;
-        remaining_size -= num_bytes;
-    }
+    };
+    ForEachContiguousRun(gpu_addr, size, flush);
 }
 
 void MemoryManager::CopyBlock(GPUVAddr gpu_dest_addr, GPUVAddr gpu_src_addr, std::size_t size) {
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "common/common_types.h"
@@ -68,6 +72,9 @@ static_assert(sizeof(PageEntry) == 4, "PageEntry is too large");
 
 class MemoryManager final {
 public:
+    /// GPU address and size of a range mapped by the guest
+    using MapRange = std::pair<GPUVAddr, size_t>;
+
     explicit MemoryManager(Core::System& system_);
     ~MemoryManager();
 
@@ -88,6 +95,11 @@ public:
     /// Returns the number of bytes until the end of the memory map containing the given GPU address
     [[nodiscard]] size_t BytesToMapEnd(GPUVAddr gpu_addr) const noexcept;
 
+    /// Returns the ranges currently mapped in the GPU address space, sorted by address
+    [[nodiscard]] std::vector<MapRange> GetMappedRanges() const {
+        return map_ranges;
+    }
+
     /**
      * ReadBlock and WriteBlock are full read and write operations over virtual
      * GPU Memory. It's important to use these when GPU memory may not be continuous
@@ -132,39 +144,78 @@ public:
     void InvalidateQueuedCaches();
 
 private:
+    static constexpr u64 address_space_size = 1ULL << 40;
+    static constexpr u64 address_space_start = 1ULL << 32;
+    static constexpr u64 address_space_start_low = 1ULL << 16;
+    static constexpr u64 page_bits{16};
+    static constexpr u64 page_size{1 << page_bits};
+    static constexpr u64 page_mask{page_size - 1};
+    static constexpr u64 big_page_bits{21};
+    static constexpr u64 big_page_size{1 << big_page_bits};
+    static constexpr u64 big_page_mask{big_page_size - 1};
+    static constexpr u64 big_page_table_size{address_space_size >> big_page_bits};
+    static constexpr u64 pages_per_big_page{big_page_size / page_size};
+
+    /// Entries of a big page that is not mapped as a single contiguous run
+    using SmallPageTable = std::array<PageEntry, pages_per_big_page>;
+
     [[nodiscard]] PageEntry GetPageEntry(GPUVAddr gpu_addr) const;
-    void SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size = page_size);
+
+    /**
+     * Translates a GPU address to a CPU address, returning it together with the number of bytes
+     * until the end of the page table entry that backs it.
+     */
+    [[nodiscard]] std::pair<std::optional<VAddr>, u64> TranslateEntry(GPUVAddr gpu_addr) const;
+
+    /**
+     * Calls func(cpu_addr, offset, size) for each run of the given GPU range that is contiguous in
+     * CPU memory, or unmapped as a whole. Runs are translated once instead of once per page.
+     */
+    template <typename Func>
+    void ForEachContiguousRun(GPUVAddr gpu_addr, std::size_t size, Func&& func) const;
+
     GPUVAddr UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size);
     [[nodiscard]] std::optional<GPUVAddr> FindFreeRange(std::size_t size, std::size_t align,
                                                         bool start_32bit_address = false) const;
 
+    /// Tracks [begin, end) as unmapped, merging it with its neighbours
+    void InsertFreeRange(GPUVAddr begin, GPUVAddr end);
+    /// Stops tracking [begin, end) as unmapped
+    void EraseFreeRange(GPUVAddr begin, GPUVAddr end);
+
+    /// Returns the small page table of a big page, splitting its big page entry if needed
+    [[nodiscard]] SmallPageTable& GetSmallPageTable(std::size_t big_page_index);
+
     void TryLockPage(PageEntry page_entry, std::size_t size);
     void TryUnlockPage(PageEntry page_entry, std::size_t size);
 
     void FlushRegion(GPUVAddr gpu_addr, size_t size) const;
 
-    [[nodiscard]] static constexpr std::size_t PageEntryIndex(GPUVAddr gpu_addr) {
-        return (gpu_addr >> page_bits) & page_table_mask;
+    [[nodiscard]] static constexpr std::size_t BigPageIndex(GPUVAddr gpu_addr) {
+        return (gpu_addr >> big_page_bits) & (big_page_table_size - 1);
     }
 
-    static constexpr u64 address_space_size = 1ULL << 40;
-    static constexpr u64 address_space_start = 1ULL << 32;
-    static constexpr u64 address_space_start_low = 1ULL << 16;
-    static constexpr u64 page_bits{16};
-    static constexpr u64 page_size{1 << page_bits};
-    static constexpr u64 page_mask{page_size - 1};
-    static constexpr u64 page_table_bits{24};
-    static constexpr u64 page_table_size{1 << page_table_bits};
-    static constexpr u64 page_table_mask{page_table_size - 1};
+    [[nodiscard]] static constexpr std::size_t SmallPageIndex(GPUVAddr gpu_addr) {
+        return (gpu_addr & big_page_mask) >> page_bits;
+    }
 
     Core::System& system;
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
 
-    std::vector<PageEntry> page_table;
+    /// Entries covering a whole big page, only used when the big page has no small page table
+    std::vector<PageEntry> big_page_table;
+    /// Small page tables of big pages mapped with a finer granularity, allocated on demand. The GPU
+    /// thread reads them without locking, so they are published atomically and never freed, a big
+    /// page that is mapped as a whole again only unpublishes its table and reuses it later.
+    std::vector<std::atomic<SmallPageTable*>> small_page_tables;
+    std::vector<std::unique_ptr<SmallPageTable>> small_page_table_storage;
+
+    /// Unmapped regions of the address space keyed by their start address, with their size
+    std::map<GPUVAddr, u64> free_ranges;
+
     std::vector<std::pair<VAddr, std::size_t>> cache_invalidate_queue;
 
-    using MapRange = std::pair<GPUVAddr, size_t>;
     std::vector<MapRange> map_ranges;
 };
 
@@ -8,7 +8,9 @@
 #include <array>
 #include <cstring>
 #include <iterator>
+#include <list>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <unordered_map>
@@ -157,11 +159,12 @@ public:
         }
     }
 
-    /// Returns a new host counter.
+    /// Returns a new host counter. Counters are recycled through a pool owned by the cache.
     std::shared_ptr<HostCounter> Counter(std::shared_ptr<HostCounter> dependency,
                                          VideoCore::QueryType type) {
-        return std::make_shared<HostCounter>(static_cast<QueryCache&>(*this), std::move(dependency),
-                                             type);
+        const std::pmr::polymorphic_allocator<HostCounter> allocator{&counter_pool};
+        return std::allocate_shared<HostCounter>(allocator, static_cast<QueryCache&>(*this),
+                                                 std::move(dependency), type);
     }
 
     /// Returns the counter stream of the specified type.
@@ -174,8 +177,12 @@ public:
         return streams[static_cast<std::size_t>(type)];
     }
 
-    void CommitAsyncFlushes() {
-        committed_flushes.push_back(uncommitted_flushes);
+    /// Commits the pending query flushes, to be performed once the given fence is released.
+    void CommitAsyncFlushes(u64 fence_value) {
+        if (!uncommitted_flushes) {
+            return;
+        }
+        committed_flushes.emplace_back(fence_value, std::move(uncommitted_flushes));
         uncommitted_flushes.reset();
     }
 
@@ -183,29 +190,49 @@ public:
         return uncommitted_flushes != nullptr;
     }
 
-    bool ShouldWaitAsyncFlushes() const {
-        if (committed_flushes.empty()) {
-            return false;
+    /**
+     * Writes back the queries committed up to the given fence whose results are available.
+     * Queries still in flight are not waited on, they stay cached and are retried on the next
+     * fence or written back when the guest reads their memory.
+     */
+    void PopAsyncFlushes(u64 fence_value) {
+        std::unique_lock lock{mutex};
+        while (!committed_flushes.empty() && committed_flushes.front().first <= fence_value) {
+            const auto& addresses = *committed_flushes.front().second;
+            deferred_flushes.insert(addresses.begin(), addresses.end());
+            committed_flushes.pop_front();
         }
-        return committed_flushes.front() != nullptr;
+        FlushReadyDeferredQueries();
     }
 
-    void PopAsyncFlushes() {
-        if (committed_flushes.empty()) {
-            return;
-        }
-        auto& flush_list = committed_flushes.front();
-        if (!flush_list) {
-            committed_flushes.pop_front();
-            return;
-        }
-        for (VAddr query_address : *flush_list) {
-            FlushAndRemoveRegion(query_address, 4);
-        }
-        committed_flushes.pop_front();
+    /// Returns true when fenced queries are still waiting for their results. Only called from the
+    /// GPU thread, which is the only one modifying them.
+    bool HasDeferredFlushes() const {
+        return !deferred_flushes.empty();
+    }
+
+    /// Writes back the deferred queries whose results became available since the last fence.
+    void RetryDeferredFlushes() {
+        std::unique_lock lock{mutex};
+        FlushReadyDeferredQueries();
     }
 
 private:
+    /// Writes back and forgets the deferred queries whose results are available.
+    void FlushReadyDeferredQueries() {
+        for (auto it = deferred_flushes.begin(); it != deferred_flushes.end();) {
+            CachedQuery* const query = TryGet(*it);
+            if (query && !query->IsReady()) {
+                ++it;
+                continue;
+            }
+            if (query) {
+                FlushAndRemoveRegion(*it, 4);
+            }
+            it = deferred_flushes.erase(it);
+        }
+    }
+
     /// Flushes a memory range to guest memory and removes it from the cache.
     void FlushAndRemoveRegion(VAddr addr, std::size_t size) {
         const u64 addr_begin = static_cast<u64>(addr);
@@ -272,12 +299,15 @@ private:
 
     std::recursive_mutex mutex;
 
+    std::pmr::unsynchronized_pool_resource counter_pool;
+
     std::unordered_map<u64, std::vector<CachedQuery>> cached_queries;
 
     std::array<CounterStream, VideoCore::NumQueryTypes> streams;
 
     std::shared_ptr<std::unordered_set<VAddr>> uncommitted_flushes{};
-    std::list<std::shared_ptr<std::unordered_set<VAddr>>> committed_flushes;
+    std::list<std::pair<u64, std::shared_ptr<std::unordered_set<VAddr>>>> committed_flushes;
+    std::unordered_set<VAddr> deferred_flushes; ///< Fenced queries waiting for their results.
 };
 
 template <class QueryCache, class HostCounter>
@@ -311,6 +341,14 @@ public:
         return *result;
     }
 
+    /// Returns true when this counter and its dependencies can be read without waiting.
+    bool IsReady() const {
+        if (result) {
+            return true;
+        }
+        return IsQueryAvailable() && (!dependency || dependency->IsReady());
+    }
+
     /// Returns true when flushing this query will potentially wait.
     bool WaitPending() const noexcept {
         return result.has_value();
@@ -324,6 +362,9 @@ protected:
     /// Returns the value of query from the backend API blocking as needed.
     virtual u64 BlockingQuery() const = 0;
 
+    /// Returns true when the backend API has the value of the query available, without blocking.
+    virtual bool IsQueryAvailable() const = 0;
+
 private:
     std::shared_ptr<HostCounter> dependency; ///< Counter to add to this value.
     std::optional<u64> result;               ///< Filled with the already returned value.
@@ -367,6 +408,11 @@ public:
         timestamp = timestamp_;
     }
 
+    /// Returns true when flushing the query will not wait for the host GPU.
+    bool IsReady() const {
+        return !counter || counter->IsReady();
+    }
+
     VAddr GetCpuAddr() const noexcept {
         return cpu_addr;
     }
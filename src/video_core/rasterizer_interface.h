@@ -84,6 +84,11 @@ public:
     /// Notify rasterizer that any caches of the specified region are desync with guest
     virtual void OnCPUWrite(VAddr addr, u64 size) = 0;
 
+    /// Write data inlined in the command stream to GPU memory, letting caches that hold a copy of
+    /// the region take the data directly instead of reuploading it from guest memory
+    virtual void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
+                                          std::span<const u8> memory) = 0;
+
     /// Sync memory between guest and host.
     virtual void SyncGuestHost() = 0;
 
@@ -0,0 +1,88 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Null {
+
+RasterizerNull::RasterizerNull(Core::Memory::Memory& cpu_memory_, Tegra::GPU& gpu_)
+    : RasterizerAccelerated{cpu_memory_}, gpu{gpu_}, gpu_memory{gpu.MemoryManager()} {}
+
+RasterizerNull::~RasterizerNull() = default;
+
+void RasterizerNull::Draw(bool is_indexed, bool is_instanced) {}
+
+void RasterizerNull::Clear() {}
+
+void RasterizerNull::DispatchCompute(GPUVAddr code_addr) {}
+
+void RasterizerNull::ResetCounter(VideoCore::QueryType type) {}
+
+void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+                           std::optional<u64> timestamp) {
+    // There is no host query to resolve, report zero samples the same way the query cache does
+    // for a counter that has just been reset.
+    if (!timestamp) {
+        gpu_memory.Write<u64>(gpu_addr, 0);
+        return;
+    }
+    const std::array<u64, 2> result{0, *timestamp};
+    gpu_memory.WriteBlockUnsafe(gpu_addr, result.data(), sizeof(result));
+}
+
+void RasterizerNull::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
+                                               u32 size) {}
+
+void RasterizerNull::FlushAll() {}
+
+void RasterizerNull::FlushRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::InvalidateExceptTextureCache(VAddr addr, u64 size) {}
+
+void RasterizerNull::InvalidateTextureCache(VAddr addr, u64 size) {}
+
+bool RasterizerNull::MustFlushRegion(VAddr addr, u64 size) {
+    return false;
+}
+
+void RasterizerNull::InvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::OnCPUWrite(VAddr addr, u64 size) {}
+
+void RasterizerNull::AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
+                                              std::span<const u8> memory) {
+    gpu_memory.WriteBlock(address, memory.data(), copy_size);
+}
+
+void RasterizerNull::SyncGuestHost() {}
+
+void RasterizerNull::UnmapMemory(VAddr addr, u64 size) {}
+
+void RasterizerNull::SignalSemaphore(GPUVAddr addr, u32 value) {
+    gpu_memory.Write<u32>(addr, value);
+}
+
+void RasterizerNull::SignalSyncPoint(u32 value) {
+    gpu.IncrementSyncPoint(value);
+}
+
+void RasterizerNull::ReleaseFences() {}
+
+void RasterizerNull::FlushAndInvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::WaitForIdle() {}
+
+void RasterizerNull::FragmentBarrier() {}
+
+void RasterizerNull::TiledCacheBarrier() {}
+
+void RasterizerNull::FlushCommands() {}
+
+void RasterizerNull::TickFrame() {}
+
+} // namespace Null
@@ -0,0 +1,80 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <span>
+
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "core/frontend/emu_window.h"
+#include "core/memory.h"
+#include "video_core/renderer_null/renderer_null.h"
+#include "video_core/surface.h"
+#include "video_core/textures/decoders.h"
+
+MICROPROFILE_DEFINE(Null_LoadFramebuffer, "Null", "Load Framebuffer", MP_RGB(128, 128, 192));
+
+namespace Null {
+
+RendererNull::RendererNull(Core::Frontend::EmuWindow& emu_window_,
+                           Core::Memory::Memory& cpu_memory_, Tegra::GPU& gpu_,
+                           std::unique_ptr<Core::Frontend::GraphicsContext> context_)
+    : RendererBase{emu_window_, std::move(context_)}, cpu_memory{cpu_memory_},
+      rasterizer{cpu_memory, gpu_} {
+    LOG_INFO(Render_Null, "Host rendering is disabled, frames will not be displayed");
+}
+
+RendererNull::~RendererNull() = default;
+
+void RendererNull::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    if (!framebuffer) {
+        return;
+    }
+    LoadFramebuffer(*framebuffer);
+    RenderScreenshot();
+
+    ++m_current_frame;
+
+    rasterizer.TickFrame();
+
+    render_window.OnFrameDisplayed();
+}
+
+void RendererNull::LoadFramebuffer(const Tegra::FramebufferConfig& framebuffer) {
+    MICROPROFILE_SCOPE(Null_LoadFramebuffer);
+
+    const VAddr framebuffer_addr{framebuffer.address + framebuffer.offset};
+    const u8* const host_ptr{cpu_memory.GetPointer(framebuffer_addr)};
+    if (host_ptr == nullptr) {
+        return;
+    }
+
+    constexpr u32 block_height_log2 = 4;
+    const auto pixel_format{
+        VideoCore::Surface::PixelFormatFromGPUPixelFormat(framebuffer.pixel_format)};
+    const u32 bytes_per_pixel{VideoCore::Surface::BytesPerBlock(pixel_format)};
+    const u64 size_in_bytes{Tegra::Texture::CalculateSize(
+        true, bytes_per_pixel, framebuffer.stride, framebuffer.height, 1, block_height_log2, 0)};
+    const std::span<const u8> input_data(host_ptr, size_in_bytes);
+
+    // Keep the decode buffer around, it only grows when the guest changes its framebuffer size
+    const size_t linear_size{static_cast<size_t>(framebuffer.stride) * framebuffer.height *
+                             bytes_per_pixel};
+    if (framebuffer_data.size() < linear_size) {
+        framebuffer_data.resize(linear_size);
+    }
+    Tegra::Texture::UnswizzleTexture(framebuffer_data, input_data, bytes_per_pixel,
+                                     framebuffer.width, framebuffer.height, 1, block_height_log2,
+                                     0);
+}
+
+void RendererNull::RenderScreenshot() {
+    if (!renderer_settings.screenshot_requested) {
+        return;
+    }
+    LOG_WARNING(Render_Null, "Screenshots are not supported by the null renderer");
+    renderer_settings.screenshot_complete_callback();
+    renderer_settings.screenshot_requested = false;
+}
+
+} // namespace Null
@@ -0,0 +1,57 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/renderer_base.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Core::Frontend {
+class EmuWindow;
+}
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace Tegra {
+class GPU;
+}
+
+namespace Null {
+
+/// Renderer without a host graphics API. Guest command processing runs as usual and presented
+/// frames are decoded into host memory, which makes it usable on machines without a GPU.
+class RendererNull final : public VideoCore::RendererBase {
+public:
+    explicit RendererNull(Core::Frontend::EmuWindow& emu_window_, Core::Memory::Memory& cpu_memory_,
+                          Tegra::GPU& gpu_,
+                          std::unique_ptr<Core::Frontend::GraphicsContext> context_);
+    ~RendererNull() override;
+
+    void SwapBuffers(const Tegra::FramebufferConfig* framebuffer) override;
+
+    VideoCore::RasterizerInterface* ReadRasterizer() override {
+        return &rasterizer;
+    }
+
+private:
+    /// Unswizzles the guest framebuffer into framebuffer_data.
+    void LoadFramebuffer(const Tegra::FramebufferConfig& framebuffer);
+
+    /// Completes a pending screenshot request, there is no image to capture.
+    void RenderScreenshot();
+
+    Core::Memory::Memory& cpu_memory;
+
+    RasterizerNull rasterizer;
+
+    std::vector<u8> framebuffer_data;
+};
+
+} // namespace Null
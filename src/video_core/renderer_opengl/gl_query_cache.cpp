@@ -85,6 +85,12 @@ u64 HostCounter::BlockingQuery() const {
     return static_cast<u64>(value);
 }
 
+bool HostCounter::IsQueryAvailable() const {
+    GLint available;
+    glGetQueryObjectiv(query.handle, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available == GL_TRUE;
+}
+
 CachedQuery::CachedQuery(QueryCache& cache_, VideoCore::QueryType type_, VAddr cpu_addr_,
                          u8* host_ptr_)
     : CachedQueryBase{cpu_addr_, host_ptr_}, cache{&cache_}, type{type_} {}
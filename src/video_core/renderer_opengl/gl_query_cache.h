@@ -55,6 +55,8 @@ public:
 private:
     u64 BlockingQuery() const override;
 
+    bool IsQueryAvailable() const override;
+
     QueryCache& cache;
     const VideoCore::QueryType type;
     OGLQuery query;
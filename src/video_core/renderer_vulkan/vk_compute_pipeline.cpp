@@ -32,8 +32,11 @@ VkDescriptorSet VKComputePipeline::CommitDescriptorSet() {
     if (!descriptor_template) {
         return {};
     }
-    const VkDescriptorSet set = descriptor_allocator.Commit();
-    update_descriptor_queue.Send(*descriptor_template, set);
+    const auto [set, is_cached] = descriptor_allocator.CommitCached(
+        update_descriptor_queue.Key(), update_descriptor_queue.Frame());
+    if (!is_cached) {
+        update_descriptor_queue.Send(*descriptor_template, set);
+    }
     return set;
 }
 
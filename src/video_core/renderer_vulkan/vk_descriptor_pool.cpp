@@ -2,9 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <vector>
 
+#include "common/cityhash.h"
 #include "common/common_types.h"
+#include "common/logging/log.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -16,6 +19,14 @@ namespace Vulkan {
 // Prefer small grow rates to avoid saturating the descriptor pool with barely used pipelines.
 constexpr std::size_t SETS_GROW_RATE = 0x20;
 
+// Maximum number of sets kept in the cache of a single layout
+constexpr std::size_t MAX_CACHED_SETS = 0x40;
+
+// Sets unused for this many frames are not reused, the resources they reference might have been
+// destroyed and their handles recycled. Keep it below the texture and buffer caches destruction
+// delays.
+constexpr u64 MAX_CACHED_FRAMES = 4;
+
 DescriptorAllocator::DescriptorAllocator(VKDescriptorPool& descriptor_pool_,
                                          VkDescriptorSetLayout layout_)
     : ResourcePool(descriptor_pool_.master_semaphore, SETS_GROW_RATE),
@@ -28,15 +39,83 @@ VkDescriptorSet DescriptorAllocator::Commit() {
     return descriptors_allocations[index / SETS_GROW_RATE][index % SETS_GROW_RATE];
 }
 
+std::pair<VkDescriptorSet, bool> DescriptorAllocator::CommitCached(std::span<const u64> key,
+                                                                  u64 frame) {
+    const char* const key_data = reinterpret_cast<const char*>(key.data());
+    const u64 hash = Common::CityHash64(key_data, key.size_bytes());
+    const u64 current_tick = descriptor_pool.master_semaphore.CurrentTick();
+    const u64 current_segment = descriptor_pool.scheduler.CurrentSegment();
+    if (const auto it = cached_lookup.find(hash); it != cached_lookup.end()) {
+        CachedSet& cached = cached_sets[it->second];
+        // Writes from a different segment of the current command buffer might be recorded by
+        // another thread after this set is bound, only reuse sets that are known to be written.
+        const bool is_written = cached.tick < current_tick || cached.segment == current_segment;
+        if (frame - cached.frame < MAX_CACHED_FRAMES && is_written &&
+            std::ranges::equal(cached.key, key)) {
+            cached.tick = current_tick;
+            cached.frame = frame;
+            ++descriptor_pool.cache_hits;
+            return {cached.set, true};
+        }
+    }
+    ++descriptor_pool.cache_misses;
+
+    CachedSet* const cached = EvictCachedSet();
+    if (!cached) {
+        return {Commit(), false};
+    }
+    const size_t index = static_cast<size_t>(cached - cached_sets.data());
+    if (const auto it = cached_lookup.find(cached->hash);
+        it != cached_lookup.end() && it->second == index) {
+        cached_lookup.erase(it);
+    }
+    cached->hash = hash;
+    cached->tick = current_tick;
+    cached->frame = frame;
+    cached->segment = current_segment;
+    cached->key.assign(key.begin(), key.end());
+    cached_lookup.insert_or_assign(hash, index);
+    return {cached->set, false};
+}
+
 void DescriptorAllocator::Allocate(std::size_t begin, std::size_t end) {
     descriptors_allocations.push_back(descriptor_pool.AllocateDescriptors(layout, end - begin));
 }
 
-VKDescriptorPool::VKDescriptorPool(const Device& device_, VKScheduler& scheduler)
-    : device{device_}, master_semaphore{scheduler.GetMasterSemaphore()}, active_pool{
-                                                                             AllocateNewPool()} {}
+DescriptorAllocator::CachedSet* DescriptorAllocator::EvictCachedSet() {
+    for (size_t i = 0; i < cached_sets.size(); ++i) {
+        const size_t index = (eviction_cursor + i) % cached_sets.size();
+        if (descriptor_pool.master_semaphore.IsFree(cached_sets[index].tick)) {
+            eviction_cursor = (index + 1) % cached_sets.size();
+            return &cached_sets[index];
+        }
+    }
+    if (cached_sets.size() >= MAX_CACHED_SETS) {
+        return nullptr;
+    }
+    const size_t first = cached_sets.size();
+    auto& sets = cached_allocations.emplace_back(
+        descriptor_pool.AllocateDescriptors(layout, SETS_GROW_RATE));
+    for (size_t i = 0; i < SETS_GROW_RATE; ++i) {
+        cached_sets.push_back(CachedSet{.set = sets[i]});
+    }
+    eviction_cursor = first + 1;
+    return &cached_sets[first];
+}
 
-VKDescriptorPool::~VKDescriptorPool() = default;
+VKDescriptorPool::VKDescriptorPool(const Device& device_, VKScheduler& scheduler_)
+    : device{device_}, scheduler{scheduler_}, master_semaphore{scheduler_.GetMasterSemaphore()},
+      active_pool{AllocateNewPool()} {}
+
+VKDescriptorPool::~VKDescriptorPool() {
+    const u64 lookups = cache_hits + cache_misses;
+    if (lookups == 0) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Descriptor set cache: {} hits, {} misses, {:.1f}% hit rate",
+             cache_hits, cache_misses,
+             static_cast<double>(cache_hits) * 100.0 / static_cast<double>(lookups));
+}
 
 vk::DescriptorPool* VKDescriptorPool::AllocateNewPool() {
     static constexpr u32 num_sets = 0x20000;
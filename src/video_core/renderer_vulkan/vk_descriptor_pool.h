@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <span>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
@@ -25,21 +28,47 @@ public:
 
     VkDescriptorSet Commit();
 
+    /**
+     * Returns a descriptor set for the resources identified by key, reusing a previously written
+     * set when the resources haven't changed.
+     * @param key   Resources that are going to be written to the set.
+     * @param frame Current frame, sets unused for a few frames are not reused.
+     * @returns The descriptor set and true when it already holds the resources in key.
+     */
+    std::pair<VkDescriptorSet, bool> CommitCached(std::span<const u64> key, u64 frame);
+
 protected:
     void Allocate(std::size_t begin, std::size_t end) override;
 
 private:
+    struct CachedSet {
+        VkDescriptorSet set{};
+        u64 hash = 0;
+        u64 tick = 0;
+        u64 frame = 0;
+        u64 segment = 0;
+        std::vector<u64> key;
+    };
+
+    /// Returns a cached set that is no longer in use by the GPU, or nullptr when all are busy.
+    CachedSet* EvictCachedSet();
+
     VKDescriptorPool& descriptor_pool;
     const VkDescriptorSetLayout layout;
 
     std::vector<vk::DescriptorSets> descriptors_allocations;
+
+    std::vector<vk::DescriptorSets> cached_allocations;
+    std::vector<CachedSet> cached_sets;
+    std::unordered_map<u64, size_t> cached_lookup;
+    size_t eviction_cursor = 0;
 };
 
 class VKDescriptorPool final {
     friend DescriptorAllocator;
 
 public:
-    explicit VKDescriptorPool(const Device& device, VKScheduler& scheduler);
+    explicit VKDescriptorPool(const Device& device_, VKScheduler& scheduler_);
     ~VKDescriptorPool();
 
     VKDescriptorPool(const VKDescriptorPool&) = delete;
@@ -51,8 +80,12 @@ private:
     vk::DescriptorSets AllocateDescriptors(VkDescriptorSetLayout layout, std::size_t count);
 
     const Device& device;
+    VKScheduler& scheduler;
     MasterSemaphore& master_semaphore;
 
+    u64 cache_hits = 0;
+    u64 cache_misses = 0;
+
     std::vector<vk::DescriptorPool> pools;
     vk::DescriptorPool* active_pool;
 };
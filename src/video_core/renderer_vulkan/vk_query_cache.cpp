@@ -97,6 +97,8 @@ HostCounter::HostCounter(VKQueryCache& cache_, std::shared_ptr<HostCounter> depe
                          QueryType type_)
     : HostCounterBase{std::move(dependency_)}, cache{cache_}, type{type_},
       query{cache_.AllocateQuery(type_)}, tick{cache_.GetScheduler().CurrentTick()} {
+    // Queries can't be split across command buffers, keep render passes inline while active
+    cache.GetScheduler().RequestInlineRecording();
     const vk::Device* logical = &cache.GetDevice().GetLogical();
     cache.GetScheduler().Record([logical, query = query](vk::CommandBuffer cmdbuf) {
         logical->ResetQueryPoolEXT(query.first, query.second, 1);
@@ -111,6 +113,7 @@ HostCounter::~HostCounter() {
 void HostCounter::EndQuery() {
     cache.GetScheduler().Record(
         [query = query](vk::CommandBuffer cmdbuf) { cmdbuf.EndQuery(query.first, query.second); });
+    cache.GetScheduler().ReleaseInlineRecording();
 }
 
 u64 HostCounter::BlockingQuery() const {
@@ -134,4 +137,9 @@ u64 HostCounter::BlockingQuery() const {
     }
 }
 
+bool HostCounter::IsQueryAvailable() const {
+    // Results are available once the command buffer that ended the query has completed
+    return tick < cache.GetScheduler().CurrentTick() && cache.GetScheduler().IsFree(tick);
+}
+
 } // namespace Vulkan
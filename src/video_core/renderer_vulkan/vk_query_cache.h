@@ -87,6 +87,8 @@ public:
 private:
     u64 BlockingQuery() const override;
 
+    bool IsQueryAvailable() const override;
+
     VKQueryCache& cache;
     const VideoCore::QueryType type;
     const std::pair<VkQueryPool, u32> query;
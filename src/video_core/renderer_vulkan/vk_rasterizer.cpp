@@ -265,6 +265,19 @@ void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     SCOPE_EXIT({ gpu.TickWork(); });
     FlushWork();
 
+    // Transform feedback buffers are bound before the render pass begins, so the pass can't be
+    // recorded in a separate command buffer
+    const bool is_transform_feedback =
+        maxwell3d.regs.tfb_enabled != 0 && device.IsExtTransformFeedbackSupported();
+    if (is_transform_feedback) {
+        scheduler.RequestInlineRecording();
+    }
+    SCOPE_EXIT({
+        if (is_transform_feedback) {
+            scheduler.ReleaseInlineRecording();
+        }
+    });
+
     query_cache.UpdateCounters();
 
     GraphicsPipelineCacheKey key;
@@ -550,6 +563,30 @@ void RasterizerVulkan::OnCPUWrite(VAddr addr, u64 size) {
     }
 }
 
+void RasterizerVulkan::AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
+                                                std::span<const u8> memory) {
+    const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(address);
+    if (!cpu_addr || copy_size == 0 ||
+        gpu_memory.GpuToCpuAddress(address + copy_size - 1) != *cpu_addr + copy_size - 1) {
+        // The destination is not contiguous in guest memory, take the slow path
+        gpu_memory.WriteBlock(address, memory.data(), copy_size);
+        return;
+    }
+    gpu_memory.WriteBlockUnsafe(address, memory.data(), copy_size);
+    {
+        std::scoped_lock lock{texture_cache.mutex};
+        texture_cache.WriteMemory(*cpu_addr, copy_size);
+    }
+    {
+        std::scoped_lock lock{buffer_cache.mutex};
+        if (!buffer_cache.InlineMemory(*cpu_addr, copy_size, memory)) {
+            buffer_cache.WriteMemory(*cpu_addr, copy_size);
+        }
+    }
+    pipeline_cache.InvalidateRegion(*cpu_addr, copy_size);
+    query_cache.InvalidateRegion(*cpu_addr, copy_size);
+}
+
 void RasterizerVulkan::SyncGuestHost() {
     pipeline_cache.SyncGuestHost();
     {
@@ -2,12 +2,15 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <thread>
 #include <utility>
 
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/thread.h"
 #include "video_core/renderer_vulkan/vk_command_pool.h"
@@ -22,6 +25,31 @@
 namespace Vulkan {
 
 MICROPROFILE_DECLARE(Vulkan_WaitForWorker);
+MICROPROFILE_DEFINE(Vulkan_RecordSecondary, "Vulkan", "Record secondary command buffer",
+                    MP_RGB(192, 128, 128));
+
+namespace {
+VkRenderPassBeginInfo MakeRenderPassBeginInfo(VkRenderPass renderpass, VkFramebuffer framebuffer,
+                                              VkExtent2D render_area) {
+    return {
+        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+        .pNext = nullptr,
+        .renderPass = renderpass,
+        .framebuffer = framebuffer,
+        .renderArea =
+            {
+                .offset = {.x = 0, .y = 0},
+                .extent = render_area,
+            },
+        .clearValueCount = 0,
+        .pClearValues = nullptr,
+    };
+}
+
+size_t NumRecorders() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+}
+} // Anonymous namespace
 
 void VKScheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf) {
     auto command = first;
@@ -35,6 +63,8 @@ void VKScheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf) {
     command_offset = 0;
     first = nullptr;
     last = nullptr;
+    secondary_pass.reset();
+    ends_secondary_pass = false;
 }
 
 VKScheduler::VKScheduler(const Device& device_, StateTracker& state_tracker_)
@@ -44,12 +74,33 @@ VKScheduler::VKScheduler(const Device& device_, StateTracker& state_tracker_)
     AcquireNewChunk();
     AllocateNewContext();
     worker_thread = std::thread(&VKScheduler::WorkerThread, this);
+
+    const size_t num_recorders = NumRecorders();
+    for (size_t i = 0; i < num_recorders; ++i) {
+        auto& recorder = *recorders.emplace_back(std::make_unique<Recorder>());
+        recorder.command_pool = std::make_unique<CommandPool>(*master_semaphore, device,
+                                                              VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+        recorder.thread = std::thread(&VKScheduler::RecorderThread, this, std::ref(recorder));
+    }
 }
 
 VKScheduler::~VKScheduler() {
     quit = true;
     cv.notify_all();
     worker_thread.join();
+
+    for (size_t i = 0; i < recorders.size(); ++i) {
+        Recorder& recorder = *recorders[i];
+        recorder.queue.Push(nullptr);
+        recorder.thread.join();
+        if (recorder.num_passes == 0) {
+            continue;
+        }
+        const auto record_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(recorder.record_time);
+        LOG_INFO(Render_Vulkan, "Recording thread {} recorded {} render passes in {} ms", i,
+                 recorder.num_passes, record_ms.count());
+    }
 }
 
 void VKScheduler::Flush(VkSemaphore semaphore) {
@@ -66,13 +117,17 @@ void VKScheduler::Finish(VkSemaphore semaphore) {
 
 void VKScheduler::WaitWorker() {
     MICROPROFILE_SCOPE(Vulkan_WaitForWorker);
+    if (state.is_secondary_pass) {
+        // The pass has to be sealed for the worker to record it
+        EndRenderPass();
+    }
     DispatchWork();
 
     bool finished = false;
     do {
         cv.notify_all();
         std::unique_lock lock{mutex};
-        finished = chunk_queue.Empty();
+        finished = chunk_queue.Empty() && deferred_work.empty() && !building_pass;
     } while (!finished);
 }
 
@@ -92,6 +147,8 @@ void VKScheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     if (renderpass == state.renderpass && framebuffer_handle == state.framebuffer &&
         render_area.width == state.render_area.width &&
         render_area.height == state.render_area.height) {
+        // Index buffers only have to be replayed for the draw that begins a pass
+        bindings.index_buffer.reset();
         return;
     }
     EndRenderPass();
@@ -99,22 +156,27 @@ void VKScheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     state.framebuffer = framebuffer_handle;
     state.render_area = render_area;
 
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
-        const VkRenderPassBeginInfo renderpass_bi{
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            .pNext = nullptr,
-            .renderPass = renderpass,
-            .framebuffer = framebuffer_handle,
-            .renderArea =
-                {
-                    .offset = {.x = 0, .y = 0},
-                    .extent = render_area,
-                },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
-        };
-        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
-    });
+    if (num_inline_requests == 0 && !recorders.empty()) {
+        // Start the pass on a fresh chunk, the worker begins the pass and hands its chunks to a
+        // recording thread. Secondary command buffers don't inherit any state.
+        DispatchWork();
+        ++segment;
+        chunk->BeginSecondaryPass({renderpass, framebuffer_handle, render_area});
+        state.is_secondary_pass = true;
+        InvalidateState();
+        ReplayBindings();
+    } else {
+        Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
+            const VkRenderPassBeginInfo renderpass_bi =
+                MakeRenderPassBeginInfo(renderpass, framebuffer_handle, render_area);
+            cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
+        });
+        if (bindings.needs_replay) {
+            ReplayBindings();
+        }
+    }
+    bindings.index_buffer.reset();
+
     num_renderpass_images = framebuffer->NumImages();
     renderpass_images = framebuffer->Images();
     renderpass_image_ranges = framebuffer->ImageRanges();
@@ -134,21 +196,170 @@ void VKScheduler::BindGraphicsPipeline(VkPipeline pipeline) {
     });
 }
 
+void VKScheduler::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type) {
+    bindings.index_buffer = IndexBinding{buffer, offset, index_type};
+    Record([buffer, offset, index_type](vk::CommandBuffer cmdbuf) {
+        cmdbuf.BindIndexBuffer(buffer, offset, index_type);
+    });
+}
+
+void VKScheduler::BindVertexBuffer(u32 index, VkBuffer buffer, VkDeviceSize offset,
+                                   VkDeviceSize size, VkDeviceSize stride) {
+    bindings.vertex_buffers[index] = VertexBinding{buffer, offset, size, stride};
+    bindings.bound_vertex_buffers[index] = true;
+    if (device.IsExtExtendedDynamicStateSupported()) {
+        Record([index, buffer, offset, size, stride](vk::CommandBuffer cmdbuf) {
+            const VkDeviceSize vk_size = buffer != VK_NULL_HANDLE ? size : VK_WHOLE_SIZE;
+            cmdbuf.BindVertexBuffers2EXT(index, 1, &buffer, &offset, &vk_size, &stride);
+        });
+    } else {
+        Record([index, buffer, offset](vk::CommandBuffer cmdbuf) {
+            cmdbuf.BindVertexBuffer(index, buffer, offset);
+        });
+    }
+}
+
+void VKScheduler::RequestInlineRecording() {
+    if (num_inline_requests++ == 0 && state.is_secondary_pass) {
+        EndRenderPass();
+    }
+}
+
+void VKScheduler::ReleaseInlineRecording() {
+    --num_inline_requests;
+}
+
 void VKScheduler::WorkerThread() {
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
     std::unique_lock lock{mutex};
     do {
-        cv.wait(lock, [this] { return !chunk_queue.Empty() || quit; });
+        cv.wait(lock, [this] { return !chunk_queue.Empty() || IsDeferredWorkReady() || quit; });
         if (quit) {
             continue;
         }
-        auto extracted_chunk = std::move(chunk_queue.Front());
-        chunk_queue.Pop();
-        extracted_chunk->ExecuteAll(current_cmdbuf);
-        chunk_reserve.Push(std::move(extracted_chunk));
+        if (!chunk_queue.Empty()) {
+            auto extracted_chunk = std::move(chunk_queue.Front());
+            chunk_queue.Pop();
+            ProcessChunk(std::move(extracted_chunk));
+        }
+        ExecuteDeferredWork();
     } while (!quit);
 }
 
+void VKScheduler::RecorderThread(Recorder& recorder) {
+    Common::SetCurrentThreadName("yuzu:VulkanRecorder");
+    Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    while (SecondaryPassRecording* const pass = recorder.queue.PopWait()) {
+        MICROPROFILE_SCOPE(Vulkan_RecordSecondary);
+        const auto start_time = std::chrono::steady_clock::now();
+
+        const VkCommandBufferInheritanceInfo inheritance_info{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+            .pNext = nullptr,
+            .renderPass = pass->info.renderpass,
+            .subpass = 0,
+            .framebuffer = pass->info.framebuffer,
+            .occlusionQueryEnable = VK_FALSE,
+            .queryFlags = 0,
+            .pipelineStatistics = 0,
+        };
+        const vk::CommandBuffer cmdbuf(recorder.command_pool->Commit(),
+                                       device.GetDispatchLoader());
+        cmdbuf.Begin({
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pNext = nullptr,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                     VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+            .pInheritanceInfo = &inheritance_info,
+        });
+        for (const auto& pass_chunk : pass->chunks) {
+            pass_chunk->ExecuteAll(cmdbuf);
+        }
+        cmdbuf.End();
+
+        recorder.record_time += std::chrono::steady_clock::now() - start_time;
+        ++recorder.num_passes;
+        {
+            std::scoped_lock lock{mutex};
+            pass->cmdbuf = cmdbuf;
+            pass->is_recorded = true;
+        }
+        cv.notify_all();
+    }
+}
+
+void VKScheduler::ProcessChunk(std::unique_ptr<CommandChunk> extracted_chunk) {
+    if (const auto& info = extracted_chunk->SecondaryPass()) {
+        building_pass = std::make_unique<SecondaryPassRecording>();
+        building_pass->info = *info;
+    }
+    if (building_pass) {
+        const bool ends_pass = extracted_chunk->EndsSecondaryPass();
+        building_pass->chunks.push_back(std::move(extracted_chunk));
+        if (ends_pass) {
+            recorders[next_recorder]->queue.Push(building_pass.get());
+            next_recorder = (next_recorder + 1) % recorders.size();
+            deferred_work.push_back({nullptr, std::move(building_pass)});
+        }
+        return;
+    }
+    if (!deferred_work.empty()) {
+        // Keep submission order, previous passes are still being recorded
+        deferred_work.push_back({std::move(extracted_chunk), nullptr});
+        return;
+    }
+    extracted_chunk->ExecuteAll(current_cmdbuf);
+    chunk_reserve.Push(std::move(extracted_chunk));
+}
+
+void VKScheduler::ExecuteDeferredWork() {
+    while (!deferred_work.empty()) {
+        DeferredWork& work = deferred_work.front();
+        if (work.pass) {
+            if (!work.pass->is_recorded) {
+                return;
+            }
+            const RenderPassInfo& info = work.pass->info;
+            current_cmdbuf.BeginRenderPass(
+                MakeRenderPassBeginInfo(info.renderpass, info.framebuffer, info.render_area),
+                VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            current_cmdbuf.ExecuteCommands(*work.pass->cmdbuf.address());
+            for (auto& pass_chunk : work.pass->chunks) {
+                chunk_reserve.Push(std::move(pass_chunk));
+            }
+        } else {
+            work.chunk->ExecuteAll(current_cmdbuf);
+            chunk_reserve.Push(std::move(work.chunk));
+        }
+        deferred_work.pop_front();
+    }
+}
+
+bool VKScheduler::IsDeferredWorkReady() const {
+    if (deferred_work.empty()) {
+        return false;
+    }
+    const DeferredWork& work = deferred_work.front();
+    return !work.pass || work.pass->is_recorded;
+}
+
+void VKScheduler::ReplayBindings() {
+    if (bindings.index_buffer) {
+        const IndexBinding& index = *bindings.index_buffer;
+        Record([index](vk::CommandBuffer cmdbuf) {
+            cmdbuf.BindIndexBuffer(index.buffer, index.offset, index.index_type);
+        });
+    }
+    for (u32 index = 0; index < bindings.vertex_buffers.size(); ++index) {
+        if (!bindings.bound_vertex_buffers[index]) {
+            continue;
+        }
+        const VertexBinding& binding = bindings.vertex_buffers[index];
+        BindVertexBuffer(index, binding.buffer, binding.offset, binding.size, binding.stride);
+    }
+    bindings.needs_replay = false;
+}
+
 void VKScheduler::SubmitExecution(VkSemaphore semaphore) {
     EndPendingOperations();
     InvalidateState();
@@ -204,6 +415,7 @@ void VKScheduler::AllocateNewContext() {
     std::unique_lock lock{mutex};
 
     current_cmdbuf = vk::CommandBuffer(command_pool->Commit(), device.GetDispatchLoader());
+    bindings = {};
     current_cmdbuf.Begin({
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .pNext = nullptr,
@@ -231,6 +443,15 @@ void VKScheduler::EndRenderPass() {
     if (!state.renderpass) {
         return;
     }
+    if (state.is_secondary_pass) {
+        chunk->EndSecondaryPass();
+        DispatchWork();
+        ++segment;
+        // Executing secondary command buffers leaves the primary state undefined
+        state.is_secondary_pass = false;
+        InvalidateState();
+        bindings.needs_replay = true;
+    }
     Record([num_images = num_renderpass_images, images = renderpass_images,
             ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
         std::array<VkImageMemoryBarrier, 9> barriers;
@@ -4,12 +4,18 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <bitset>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <stack>
 #include <thread>
 #include <utility>
+#include <vector>
 #include "common/common_types.h"
 #include "common/threadsafe_queue.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
@@ -53,6 +59,20 @@ public:
     /// Binds a pipeline to the current execution context.
     void BindGraphicsPipeline(VkPipeline pipeline);
 
+    /// Binds an index buffer to the current execution context.
+    void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type);
+
+    /// Binds a vertex buffer to the current execution context.
+    void BindVertexBuffer(u32 index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                          VkDeviceSize stride);
+
+    /// Requests render passes to be recorded in the primary command buffer until it's released.
+    /// Used by operations that can't span multiple command buffers, like queries.
+    void RequestInlineRecording();
+
+    /// Releases a previous request to record render passes in the primary command buffer.
+    void ReleaseInlineRecording();
+
     /// Invalidates current command buffer state except for render passes
     void InvalidateState();
 
@@ -86,6 +106,12 @@ public:
         master_semaphore->Wait(tick);
     }
 
+    /// Returns an identifier of the command stream being built. Commands recorded with the same
+    /// identifier are replayed in order by a single thread.
+    [[nodiscard]] u64 CurrentSegment() const noexcept {
+        return segment;
+    }
+
     /// Returns the master timeline semaphore.
     [[nodiscard]] MasterSemaphore& GetMasterSemaphore() const noexcept {
         return *master_semaphore;
@@ -127,10 +153,34 @@ private:
         T command;
     };
 
+    struct RenderPassInfo {
+        VkRenderPass renderpass;
+        VkFramebuffer framebuffer;
+        VkExtent2D render_area;
+    };
+
     class CommandChunk final {
     public:
         void ExecuteAll(vk::CommandBuffer cmdbuf);
 
+        /// Marks this chunk as the first one of a render pass recorded in a secondary buffer.
+        void BeginSecondaryPass(const RenderPassInfo& info) {
+            secondary_pass = info;
+        }
+
+        /// Marks this chunk as the last one of a render pass recorded in a secondary buffer.
+        void EndSecondaryPass() {
+            ends_secondary_pass = true;
+        }
+
+        const std::optional<RenderPassInfo>& SecondaryPass() const {
+            return secondary_pass;
+        }
+
+        bool EndsSecondaryPass() const {
+            return ends_secondary_pass;
+        }
+
         template <typename T>
         bool Record(T& command) {
             using FuncType = TypedCommand<T>;
@@ -155,13 +205,16 @@ private:
         }
 
         bool Empty() const {
-            return command_offset == 0;
+            return command_offset == 0 && !secondary_pass && !ends_secondary_pass;
         }
 
     private:
         Command* first = nullptr;
         Command* last = nullptr;
 
+        std::optional<RenderPassInfo> secondary_pass;
+        bool ends_secondary_pass = false;
+
         std::size_t command_offset = 0;
         std::array<u8, 0x8000> data{};
     };
@@ -171,10 +224,68 @@ private:
         VkFramebuffer framebuffer = nullptr;
         VkExtent2D render_area = {0, 0};
         VkPipeline graphics_pipeline = nullptr;
+        bool is_secondary_pass = false;
+    };
+
+    struct IndexBinding {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkIndexType index_type;
+    };
+
+    struct VertexBinding {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        VkDeviceSize stride;
+    };
+
+    /// Buffer bindings of the command buffer being built, replayed when they are lost.
+    struct Bindings {
+        std::optional<IndexBinding> index_buffer;
+        std::array<VertexBinding, 32> vertex_buffers{};
+        std::bitset<32> bound_vertex_buffers;
+        bool needs_replay = false;
+    };
+
+    /// Render pass recorded in a secondary command buffer by a recording thread.
+    struct SecondaryPassRecording {
+        RenderPassInfo info;
+        std::vector<std::unique_ptr<CommandChunk>> chunks;
+        vk::CommandBuffer cmdbuf;
+        bool is_recorded = false;
+    };
+
+    /// Primary command buffer work waiting for a previous secondary pass to be recorded.
+    struct DeferredWork {
+        std::unique_ptr<CommandChunk> chunk;
+        std::unique_ptr<SecondaryPassRecording> pass;
+    };
+
+    struct Recorder {
+        std::thread thread;
+        Common::SPSCQueue<SecondaryPassRecording*> queue;
+        std::unique_ptr<CommandPool> command_pool;
+        std::chrono::nanoseconds record_time{};
+        u64 num_passes = 0;
     };
 
     void WorkerThread();
 
+    void RecorderThread(Recorder& recorder);
+
+    /// Executes a chunk on the worker thread or hands it to a recording thread.
+    void ProcessChunk(std::unique_ptr<CommandChunk> extracted_chunk);
+
+    /// Records deferred work into the primary command buffer up to a pass still being recorded.
+    void ExecuteDeferredWork();
+
+    /// Returns true when the worker has deferred work that can be executed.
+    bool IsDeferredWorkReady() const;
+
+    /// Records the buffer bindings to the current chunk.
+    void ReplayBindings();
+
     void SubmitExecution(VkSemaphore semaphore);
 
     void AllocateNewContext();
@@ -199,6 +310,14 @@ private:
     std::thread worker_thread;
 
     State state;
+    Bindings bindings;
+    u32 num_inline_requests = 0;
+    u64 segment = 0;
+
+    std::vector<std::unique_ptr<Recorder>> recorders;
+    size_t next_recorder = 0;
+    std::unique_ptr<SecondaryPassRecording> building_pass;
+    std::deque<DeferredWork> deferred_work;
 
     u32 num_renderpass_images = 0;
     std::array<VkImage, 9> renderpass_images{};
@@ -21,6 +21,7 @@ VKUpdateDescriptorQueue::~VKUpdateDescriptorQueue() = default;
 
 void VKUpdateDescriptorQueue::TickFrame() {
     payload.clear();
+    ++frame;
 }
 
 void VKUpdateDescriptorQueue::Acquire() {
@@ -34,6 +35,7 @@ void VKUpdateDescriptorQueue::Acquire() {
         payload.clear();
     }
     upload_start = &*payload.end();
+    key.clear();
 }
 
 void VKUpdateDescriptorQueue::Send(VkDescriptorUpdateTemplateKHR update_template,
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <span>
 #include <variant>
+#include <vector>
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
@@ -40,12 +42,24 @@ public:
 
     void Send(VkDescriptorUpdateTemplateKHR update_template, VkDescriptorSet set);
 
+    /// Returns the resources added since the last acquire, to look up cached descriptor sets.
+    std::span<const u64> Key() const noexcept {
+        return key;
+    }
+
+    /// Returns the number of frames ticked so far.
+    u64 Frame() const noexcept {
+        return frame;
+    }
+
     void AddSampledImage(VkImageView image_view, VkSampler sampler) {
         payload.emplace_back(VkDescriptorImageInfo{
             .sampler = sampler,
             .imageView = image_view,
             .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
         });
+        key.push_back(HandleKey(image_view));
+        key.push_back(HandleKey(sampler));
     }
 
     void AddImage(VkImageView image_view) {
@@ -54,6 +68,7 @@ public:
             .imageView = image_view,
             .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
         });
+        key.push_back(HandleKey(image_view));
     }
 
     void AddBuffer(VkBuffer buffer, u64 offset, size_t size) {
@@ -62,16 +77,28 @@ public:
             .offset = offset,
             .range = size,
         });
+        key.push_back(HandleKey(buffer));
+        key.push_back(offset);
+        key.push_back(size);
     }
 
     void AddTexelBuffer(VkBufferView texel_buffer) {
         payload.emplace_back(texel_buffer);
+        key.push_back(HandleKey(texel_buffer));
     }
 
 private:
+    template <typename Handle>
+    static u64 HandleKey(Handle handle) noexcept {
+        return reinterpret_cast<u64>(handle);
+    }
+
     const Device& device;
     VKScheduler& scheduler;
 
+    std::vector<u64> key;
+    u64 frame = 0;
+
     const DescriptorUpdateEntry* upload_start = nullptr;
     boost::container::static_vector<DescriptorUpdateEntry, 0x10000> payload;
 };
@@ -164,14 +164,11 @@ public:
     /// Return true when there are uncommitted images to be downloaded
     [[nodiscard]] bool HasUncommittedFlushes() const noexcept;
 
-    /// Return true when the caller should wait for async downloads
-    [[nodiscard]] bool ShouldWaitAsyncFlushes() const noexcept;
+    /// Commit asynchronous downloads, to be performed once the given fence is released
+    void CommitAsyncFlushes(u64 fence_value);
 
-    /// Commit asynchronous downloads
-    void CommitAsyncFlushes();
-
-    /// Pop asynchronous downloads
-    void PopAsyncFlushes();
+    /// Perform the asynchronous downloads committed up to the given fence
+    void PopAsyncFlushes(u64 fence_value);
 
     /// Return true when a CPU region is modified from the GPU
     [[nodiscard]] bool IsRegionGpuModified(VAddr addr, size_t size);
@@ -214,6 +211,9 @@ private:
     template <typename StagingBuffer>
     void UploadImageContents(Image& image, StagingBuffer& staging_buffer);
 
+    /// Download images from host and write them back to guest memory
+    void DownloadImages(std::span<const ImageId> download_ids);
+
     /// Find or create an image view from a guest descriptor
     [[nodiscard]] ImageViewId FindImageView(const TICEntry& config);
 
@@ -340,7 +340,7 @@ private:
 
     // TODO: This data structure is not optimal and it should be reworked
     std::vector<ImageId> uncommitted_downloads;
-    std::queue<std::vector<ImageId>> committed_downloads;
+    std::queue<std::pair<u64, std::vector<ImageId>>> committed_downloads;
 
     static constexpr size_t TICKS_TO_DESTROY = 6;
     DelayedDestructionRing<Image, TICKS_TO_DESTROY> sentenced_images;
@@ -724,27 +724,24 @@ bool TextureCache<P>::HasUncommittedFlushes() const noexcept {
 }
 
 template <class P>
-bool TextureCache<P>::ShouldWaitAsyncFlushes() const noexcept {
-    return !committed_downloads.empty() && !committed_downloads.front().empty();
-}
-
-template <class P>
-void TextureCache<P>::CommitAsyncFlushes() {
-    // This is intentionally passing the value by copy
-    committed_downloads.push(uncommitted_downloads);
+void TextureCache<P>::CommitAsyncFlushes(u64 fence_value) {
+    if (uncommitted_downloads.empty()) {
+        return;
+    }
+    committed_downloads.emplace(fence_value, std::move(uncommitted_downloads));
     uncommitted_downloads.clear();
 }
 
 template <class P>
-void TextureCache<P>::PopAsyncFlushes() {
-    if (committed_downloads.empty()) {
-        return;
-    }
-    const std::span<const ImageId> download_ids = committed_downloads.front();
-    if (download_ids.empty()) {
+void TextureCache<P>::PopAsyncFlushes(u64 fence_value) {
+    while (!committed_downloads.empty() && committed_downloads.front().first <= fence_value) {
+        DownloadImages(committed_downloads.front().second);
         committed_downloads.pop();
-        return;
     }
+}
+
+template <class P>
+void TextureCache<P>::DownloadImages(std::span<const ImageId> download_ids) {
     size_t total_size_bytes = 0;
     for (const ImageId image_id : download_ids) {
         total_size_bytes += slot_images[image_id].unswizzled_size_bytes;
@@ -769,7 +766,6 @@ void TextureCache<P>::PopAsyncFlushes() {
         download_map.offset += image.unswizzled_size_bytes;
         download_span = download_span.subspan(image.unswizzled_size_bytes);
     }
-    committed_downloads.pop();
 }
 
 template <class P>
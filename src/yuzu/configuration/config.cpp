@@ -754,6 +754,8 @@ void Config::ReadCpuValues() {
             ReadSetting(QStringLiteral("cpuopt_misc_ir"), true).toBool();
         Settings::values.cpuopt_reduce_misalign_checks =
             ReadSetting(QStringLiteral("cpuopt_reduce_misalign_checks"), true).toBool();
+        Settings::values.cpuopt_fastmem =
+            ReadSetting(QStringLiteral("cpuopt_fastmem"), true).toBool();
 
         Settings::values.cpuopt_unsafe_unfuse_fma =
             ReadSetting(QStringLiteral("cpuopt_unsafe_unfuse_fma"), true).toBool();
@@ -1317,6 +1319,7 @@ void Config::SaveCpuValues() {
         WriteSetting(QStringLiteral("cpuopt_misc_ir"), Settings::values.cpuopt_misc_ir, true);
         WriteSetting(QStringLiteral("cpuopt_reduce_misalign_checks"),
                      Settings::values.cpuopt_reduce_misalign_checks, true);
+        WriteSetting(QStringLiteral("cpuopt_fastmem"), Settings::values.cpuopt_fastmem, true);
 
         WriteSetting(QStringLiteral("cpuopt_unsafe_unfuse_fma"),
                      Settings::values.cpuopt_unsafe_unfuse_fma, true);
@@ -585,9 +585,12 @@ void GMainWindow::InitializeWidgets() {
     emu_frametime_label->setToolTip(
         tr("Time taken to emulate a Switch frame, not counting framelimiting or v-sync. For "
            "full-speed emulation this should be at most 16.67 ms."));
+    present_latency_label = new QLabel();
+    present_latency_label->setToolTip(
+        tr("Average time between the game queueing a frame and the frame being presented."));
 
-    for (auto& label :
-         {shader_building_label, emu_speed_label, game_fps_label, emu_frametime_label}) {
+    for (auto& label : {shader_building_label, emu_speed_label, game_fps_label,
+                        emu_frametime_label, present_latency_label}) {
         label->setVisible(false);
         label->setFrameStyle(QFrame::NoFrame);
         label->setContentsMargins(4, 0, 4, 0);
@@ -655,10 +658,10 @@ void GMainWindow::InitializeWidgets() {
     });
     renderer_status_button->toggle();
 
-    renderer_status_button->setChecked(Settings::values.renderer_backend.GetValue() ==
-                                       Settings::RendererBackend::Vulkan);
+    UpdateRendererStatusButton();
     connect(renderer_status_button, &QPushButton::clicked, [this] {
-        if (emulation_running) {
+        if (emulation_running ||
+            Settings::values.renderer_backend.GetValue() == Settings::RendererBackend::Null) {
             return;
         }
         if (renderer_status_button->isChecked()) {
@@ -1287,11 +1290,12 @@ void GMainWindow::ShutdownGame() {
     emu_speed_label->setVisible(false);
     game_fps_label->setVisible(false);
     emu_frametime_label->setVisible(false);
+    present_latency_label->setVisible(false);
     async_status_button->setEnabled(true);
     multicore_status_button->setEnabled(true);
-    renderer_status_button->setEnabled(true);
 
     emulation_running = false;
+    UpdateRendererStatusButton();
 
     game_path.clear();
 
@@ -1869,8 +1873,8 @@ void GMainWindow::OnMenuLoadFolder() {
     }
 }
 
-void GMainWindow::IncrementInstallProgress() {
-    install_progress->setValue(install_progress->value() + 1);
+void GMainWindow::IncrementInstallProgress(int increment) {
+    install_progress->setValue(install_progress->value() + increment);
 }
 
 void GMainWindow::OnMenuInstallToNAND() {
@@ -1983,27 +1987,22 @@ void GMainWindow::OnMenuInstallToNAND() {
 InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
     const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
                                     const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (install_progress->wasCanceled()) {
-                dest->Resize(0);
-                return false;
-            }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
+        std::size_t reported_units = 0;
+        const bool copied = FileSys::VfsPipelinedCopyWithProgress(
+            src, dest, block_size, [this, &reported_units](std::size_t bytes_copied) {
+                if (install_progress->wasCanceled()) {
+                    return false;
+                }
+                // The progress dialog counts in 4 KiB units
+                const std::size_t units = bytes_copied / 0x1000;
+                emit UpdateInstallProgress(static_cast<int>(units - reported_units));
+                reported_units = units;
+                return true;
+            });
+        if (!copied && dest != nullptr) {
+            dest->Resize(0);
         }
-        return true;
+        return copied;
     };
 
     std::shared_ptr<FileSys::NSP> nsp;
@@ -2037,27 +2036,22 @@ InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
 InstallResult GMainWindow::InstallNCA(const QString& filename) {
     const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
                                     const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (install_progress->wasCanceled()) {
-                dest->Resize(0);
-                return false;
-            }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
+        std::size_t reported_units = 0;
+        const bool copied = FileSys::VfsPipelinedCopyWithProgress(
+            src, dest, block_size, [this, &reported_units](std::size_t bytes_copied) {
+                if (install_progress->wasCanceled()) {
+                    return false;
+                }
+                // The progress dialog counts in 4 KiB units
+                const std::size_t units = bytes_copied / 0x1000;
+                emit UpdateInstallProgress(static_cast<int>(units - reported_units));
+                reported_units = units;
+                return true;
+            });
+        if (!copied && dest != nullptr) {
+            dest->Resize(0);
         }
-        return true;
+        return copied;
     };
 
     const auto nca =
@@ -2565,18 +2559,36 @@ void GMainWindow::UpdateStatusBar() {
     }
     game_fps_label->setText(tr("Game: %1 FPS").arg(results.game_fps, 0, 'f', 0));
     emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    present_latency_label->setText(
+        tr("Latency: %1 ms").arg(results.present_latency * 1000.0, 0, 'f', 2));
 
     emu_speed_label->setVisible(!Settings::values.use_multi_core.GetValue());
     game_fps_label->setVisible(true);
     emu_frametime_label->setVisible(true);
+    present_latency_label->setVisible(results.present_latency > 0.0);
 }
 
 void GMainWindow::UpdateStatusButtons() {
     dock_status_button->setChecked(Settings::values.use_docked_mode.GetValue());
     multicore_status_button->setChecked(Settings::values.use_multi_core.GetValue());
     async_status_button->setChecked(Settings::values.use_asynchronous_gpu_emulation.GetValue());
+    UpdateRendererStatusButton();
+}
+
+void GMainWindow::UpdateRendererStatusButton() {
     renderer_status_button->setChecked(Settings::values.renderer_backend.GetValue() ==
                                        Settings::RendererBackend::Vulkan);
+
+    // The null backend is only selected from the configuration, the button can't toggle it back
+    const bool is_null_renderer =
+        Settings::values.renderer_backend.GetValue() == Settings::RendererBackend::Null;
+    if (is_null_renderer) {
+        renderer_status_button->setText(tr("NULL"));
+    } else {
+        renderer_status_button->setText(renderer_status_button->isChecked() ? tr("VULKAN")
+                                                                            : tr("OPENGL"));
+    }
+    renderer_status_button->setEnabled(!is_null_renderer && !emulation_running);
 }
 
 void GMainWindow::UpdateUISettings() {
@@ -2711,6 +2723,8 @@ void GMainWindow::OnReinitializeKeys(ReinitializeKeyBehavior behavior) {
                            "console.keys_autogenerated");
         Common::FS::Delete(Common::FS::GetUserPath(Common::FS::UserPath::KeysDir) +
                            "title.keys_autogenerated");
+        Common::FS::Delete(Common::FS::GetUserPath(Common::FS::UserPath::KeysDir) +
+                           "keys.cache");
     }
 
     Core::Crypto::KeyManager& keys = Core::Crypto::KeyManager::Instance();
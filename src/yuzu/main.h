@@ -120,7 +120,7 @@ signals:
     // Signal that tells widgets to update icons to use the current theme
     void UpdateThemedIcons();
 
-    void UpdateInstallProgress();
+    void UpdateInstallProgress(int increment);
 
     void ControllerSelectorReconfigureFinished();
 
@@ -228,7 +228,7 @@ private slots:
     void OnGameListOpenPerGameProperties(const std::string& file);
     void OnMenuLoadFile();
     void OnMenuLoadFolder();
-    void IncrementInstallProgress();
+    void IncrementInstallProgress(int increment);
     void OnMenuInstallToNAND();
     void OnMenuRecentFile();
     void OnConfigure();
@@ -265,6 +265,7 @@ private:
                            const std::string& title_version = {});
     void UpdateStatusBar();
     void UpdateStatusButtons();
+    void UpdateRendererStatusButton();
     void UpdateUISettings();
     void HideMouseCursor();
     void ShowMouseCursor();
@@ -289,6 +290,7 @@ private:
     QLabel* emu_speed_label = nullptr;
     QLabel* game_fps_label = nullptr;
     QLabel* emu_frametime_label = nullptr;
+    QLabel* present_latency_label = nullptr;
     QPushButton* async_status_button = nullptr;
     QPushButton* multicore_status_button = nullptr;
     QPushButton* renderer_status_button = nullptr;
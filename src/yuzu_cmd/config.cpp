@@ -369,6 +369,9 @@ void Config::ReadValues() {
     Settings::values.use_multi_core.SetValue(
         sdl2_config->GetBoolean("Core", "use_multi_core", true));
 
+    // Cpu
+    Settings::values.cpuopt_fastmem = sdl2_config->GetBoolean("Cpu", "cpuopt_fastmem", true);
+
     // Renderer
     const int renderer_backend = sdl2_config->GetInteger(
         "Renderer", "backend", static_cast<int>(Settings::RendererBackend::OpenGL));
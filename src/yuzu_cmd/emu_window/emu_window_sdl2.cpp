@@ -7,6 +7,7 @@
 #include "common/scm_rev.h"
 #include "core/core.h"
 #include "core/perf_stats.h"
+#include "core/settings.h"
 #include "input_common/keyboard.h"
 #include "input_common/main.h"
 #include "input_common/mouse/mouse_input.h"
@@ -15,6 +16,10 @@
 
 EmuWindow_SDL2::EmuWindow_SDL2(InputCommon::InputSubsystem* input_subsystem_)
     : input_subsystem{input_subsystem_} {
+    if (Settings::values.renderer_backend.GetValue() == Settings::RendererBackend::Null) {
+        // Nothing is presented, don't require a display server. SDL_VIDEODRIVER still wins.
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    }
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK) < 0) {
         LOG_CRITICAL(Frontend, "Failed to initialize SDL2! Exiting...");
         exit(1);
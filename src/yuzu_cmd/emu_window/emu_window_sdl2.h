@@ -78,3 +78,6 @@ protected:
     /// Input subsystem to use with this window.
     InputCommon::InputSubsystem* input_subsystem;
 };
+
+/// Context of windows whose renderer doesn't need the frontend to make anything current
+class DummyContext : public Core::Frontend::GraphicsContext {};
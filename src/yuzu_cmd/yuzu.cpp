@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -31,10 +32,13 @@
 #include "core/settings.h"
 #include "core/telemetry_session.h"
 #include "input_common/main.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/renderer_base.h"
 #include "yuzu_cmd/config.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_vk.h"
 
 #ifdef _WIN32
@@ -65,7 +69,10 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "-c, --gpu-capture     Record the GPU command stream into the given file\n"
+                 "-r, --gpu-replay      Replay a GPU capture instead of running the title\n"
+                 "-n, --gpu-frames      Number of frames to record or replay (default 60)\n";
 }
 
 static void PrintVersion() {
@@ -107,17 +114,23 @@ int main(int argc, char** argv) {
     std::string filepath;
 
     bool fullscreen = false;
+    std::string gpu_capture_path;
+    std::string gpu_replay_path;
+    u32 gpu_frames = 60;
 
     static struct option long_options[] = {
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {"program", optional_argument, 0, 'p'},
+        {"gpu-capture", required_argument, 0, 'c'},
+        {"gpu-replay", required_argument, 0, 'r'},
+        {"gpu-frames", required_argument, 0, 'n'},
         {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::c:r:n:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'f':
@@ -134,6 +147,15 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 'c':
+                gpu_capture_path = optarg;
+                break;
+            case 'r':
+                gpu_replay_path = optarg;
+                break;
+            case 'n':
+                gpu_frames = static_cast<u32>(std::strtoul(optarg, nullptr, 0));
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -171,6 +193,9 @@ int main(int argc, char** argv) {
     case Settings::RendererBackend::Vulkan:
         emu_window = std::make_unique<EmuWindow_SDL2_VK>(&input_subsystem);
         break;
+    case Settings::RendererBackend::Null:
+        emu_window = std::make_unique<EmuWindow_SDL2_Null>(&input_subsystem);
+        break;
     }
 
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
@@ -216,6 +241,17 @@ int main(int argc, char** argv) {
         system.CurrentProcess()->GetTitleID(), false,
         [](VideoCore::LoadCallbackStage, size_t value, size_t total) {});
 
+    if (!gpu_replay_path.empty()) {
+        // The guest never runs, the capture provides both the command stream and its memory
+        const auto frame_times = system.GPU().Capture().Replay(gpu_replay_path, gpu_frames);
+        system.Shutdown();
+        detached_tasks.WaitForAllTasks();
+        return frame_times.empty() ? -1 : 0;
+    }
+    if (!gpu_capture_path.empty()) {
+        system.GPU().Capture().BeginRecording(gpu_capture_path, gpu_frames);
+    }
+
     void(system.Run());
     while (emu_window->IsOpen()) {
         emu_window->WaitEvent();